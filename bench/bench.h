@@ -0,0 +1,72 @@
+/* bench/bench.h
+ *
+ * Copyright (c) 2024 libhttp. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/* Tiny helpers shared by the benchmark executables. Numbers are only
+ * meaningful when the library is configured with CMAKE_BUILD_TYPE=Release. */
+
+#ifndef LIBHTTP_BENCH_H
+#define LIBHTTP_BENCH_H 1
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+/* Keep the optimizer from discarding a computed value */
+#define BENCH_KEEP(value) __asm__ volatile("" : : "r"(value) : "memory")
+
+static inline double bench_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Print one result line as throughput and time per operation
+ *
+ * @param name Name of the measured case
+ * @param ops Number of operations performed
+ * @param bytes Number of input bytes processed by all operations (or 0)
+ * @param seconds Elapsed wall-clock time
+ */
+static inline void
+bench_report(const char *name, uint64_t ops, uint64_t bytes, double seconds)
+{
+	if (bytes > 0)
+	{
+		printf(
+		    "%-40s %10.2f ns/op %8.3f GB/s\n",
+		    name,
+		    seconds * 1e9 / (double)ops,
+		    (double)bytes / seconds / 1e9
+		);
+	}
+	else
+	{
+		printf(
+		    "%-40s %10.2f ns/op %10.2f Mops/s\n",
+		    name,
+		    seconds * 1e9 / (double)ops,
+		    (double)ops / seconds / 1e6
+		);
+	}
+}
+
+#endif // LIBHTTP_BENCH_H
@@ -0,0 +1,90 @@
+/* Copyright (c) 2024 libhttp. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/* Per-request memory: a request buffer plus a header list of N entries,
+ * allocated with libc and torn down entry by entry, against the same work in
+ * an arena torn down with a single reset. */
+
+#include "bench.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "lhttp_arena.h"
+#include "lhttp_list.h"
+#include "lhttp_request.h"
+
+#define ITERATIONS 200000u
+
+static char names[64][16];
+
+static void build(const lhttp_allocator_t *allocator, size_t headers)
+{
+	lhttp_request_t request;
+	lhttp_list_t list;
+	size_t i;
+
+	lhttp_request_init_with_allocator(&request, 4096, allocator);
+	lhttp_list_init_with_allocator(&list, allocator);
+
+	for (i = 0; i < headers; i++)
+		lhttp_list_add(&list, names[i], "some header value");
+
+	BENCH_KEEP(list.__size);
+
+	lhttp_list_free(&list);
+	lhttp_request_free(&request);
+}
+
+static void run(size_t headers)
+{
+	lhttp_arena_t arena;
+	char name[64];
+	uint64_t i;
+	double t;
+
+	t = bench_now();
+	for (i = 0; i < ITERATIONS; i++)
+		build(NULL, headers);
+	snprintf(name, sizeof(name), "malloc/%zu headers", headers);
+	bench_report(name, ITERATIONS, 0, bench_now() - t);
+
+	lhttp_arena_init(&arena, 0, NULL);
+
+	t = bench_now();
+	for (i = 0; i < ITERATIONS; i++)
+	{
+		build(lhttp_arena_allocator(&arena), headers);
+		lhttp_arena_reset(&arena);
+	}
+	snprintf(name, sizeof(name), "arena/%zu headers", headers);
+	bench_report(name, ITERATIONS, 0, bench_now() - t);
+
+	lhttp_arena_free(&arena);
+}
+
+int main(void)
+{
+	size_t i;
+
+	for (i = 0; i < 64; i++)
+		snprintf(names[i], sizeof(names[i]), "X-Header-%zu", i);
+
+	run(4);
+	run(16);
+	run(64);
+
+	return 0;
+}
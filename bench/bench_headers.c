@@ -0,0 +1,178 @@
+/* Copyright (c) 2024 libhttp. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/* Header sections of cookie-heavy requests: finding the field boundaries and
+ * checking every value for illegal bytes, with the former line scanner plus a
+ * byte loop against the block classifier of each implementation, then the
+ * whole `lhttp_request_parse` and `lhttp_request_validate` path. */
+
+#include "bench.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "lhttp_request.h"
+#include "lhttp_scan.h"
+
+#define WORK (256u << 20)
+
+static char *make_request(size_t cookie_len, size_t *len)
+{
+	const char *head = "GET /index.html HTTP/1.1\r\n"
+	                   "Host: www.example.com\r\n"
+	                   "User-Agent: Mozilla/5.0 (X11; Linux x86_64)\r\n"
+	                   "Accept: text/html,application/xhtml+xml\r\n"
+	                   "Accept-Encoding: gzip, deflate, br\r\n"
+	                   "Accept-Language: en-US,en;q=0.9\r\n";
+	char *request = malloc(strlen(head) + 4 * (cookie_len + 16) + 3);
+	size_t i, j, n = strlen(head);
+
+	memcpy(request, head, n);
+
+	for (i = 0; i < 4; i++)
+	{
+		memcpy(request + n, "Cookie: ", 8);
+		n += 8;
+
+		for (j = 0; j < cookie_len; j++)
+			request[n++] = "session=a1b2c3d4e5f6; theme=dark; "[j % 34];
+
+		memcpy(request + n, "\r\n", 2);
+		n += 2;
+	}
+
+	memcpy(request + n, "\r\n", 3);
+	*len = n + 2;
+
+	return request;
+}
+
+/* The header section as it was indexed and validated before the classifier:
+ * one scan per name and per value, then one more pass over every value */
+static size_t scan_path(const char *p, const char *end)
+{
+	const char *colon, *eol, *v;
+	size_t bad = 0;
+
+	while (p < end && *p != '\r')
+	{
+		colon = __lhttp_scan_find(p, end, ":\r\n");
+		eol   = __lhttp_scan_find(colon, end, "\r\n");
+
+		for (v = colon + 1; v < eol; v++)
+		{
+			unsigned char c = *v;
+
+			bad += (c < 0x20 && c != '\t') || c == 0x7F;
+		}
+
+		p = eol + 2;
+	}
+
+	return bad;
+}
+
+/* The same work from the masks: bits of colons and line ends are walked, and
+ * illegal bytes are only counted */
+static size_t
+classify_path(__lhttp_classify_fn classify, const char *p, const char *end)
+{
+	__lhttp_scan_classes_t classes;
+	size_t bad = 0, fields = 0, len;
+
+	for (; p < end; p += len)
+	{
+		len = end - p < LHTTP_SCAN_BLOCK ? end - p : LHTTP_SCAN_BLOCK;
+		classify(p, len, &classes);
+
+		bad    += __builtin_popcountll(classes.illegal);
+		fields += __builtin_popcountll(classes.colon & ~classes.cr);
+	}
+
+	return bad + fields;
+}
+
+static void run(const char *label, size_t cookie_len)
+{
+	size_t len;
+	char *message     = make_request(cookie_len, &len);
+	const char *start = strstr(message, "\r\n") + 2;
+	const char *end   = message + len;
+	uint64_t iters    = WORK / len + 1;
+	lhttp_request_t request;
+	char name[64];
+	uint64_t i;
+	double t;
+	int status;
+
+	struct
+	{
+		const char *name;
+		__lhttp_classify_fn fn;
+		int available;
+	} impls[] = {
+	    {"scalar", __lhttp_scan_classify_scalar, 1},
+#ifdef LHTTP_SCAN_X86
+	    {"sse2", __lhttp_scan_classify_sse2, __lhttp_scan_has_sse2()},
+	    {"avx2", __lhttp_scan_classify_avx2, __lhttp_scan_has_avx2()},
+#endif
+	};
+
+	printf("-- %s (%zu bytes)\n", label, len);
+
+	t = bench_now();
+	for (i = 0; i < iters; i++)
+	{
+		BENCH_KEEP(start);
+		BENCH_KEEP(scan_path(start, end));
+	}
+	bench_report("scan+loop", iters, iters * (end - start), bench_now() - t);
+
+	for (size_t k = 0; k < sizeof(impls) / sizeof(impls[0]); k++)
+	{
+		if (!impls[k].available)
+			continue;
+
+		t = bench_now();
+		for (i = 0; i < iters; i++)
+		{
+			BENCH_KEEP(start);
+			BENCH_KEEP(classify_path(impls[k].fn, start, end));
+		}
+		snprintf(name, sizeof(name), "classify/%s", impls[k].name);
+		bench_report(name, iters, iters * (end - start), bench_now() - t);
+	}
+
+	// The request is parsed in place, so only the parser is measured
+	t = bench_now();
+	for (i = 0; i < iters; i++)
+	{
+		lhttp_request_init_borrowed(&request, len);
+		lhttp_request_parse(&request, message, len);
+		lhttp_request_validate(&request, &status);
+		BENCH_KEEP(status);
+	}
+	bench_report("parse+validate", iters, iters * len, bench_now() - t);
+
+	free(message);
+}
+
+int main(void)
+{
+	run("small cookies", 64);
+	run("large cookies", 1024);
+
+	return 0;
+}
@@ -0,0 +1,302 @@
+/* Copyright (c) 2024 libhttp. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/* Header lists of 8, 64 and 1024 entries: building, looking up every key and
+ * removing every key, with `lhttp_list_t` against the singly-linked list it
+ * used to be, and with borrowed entries that copy nothing. Building a list
+ * with one `lhttp_list_add_all` call instead of one add per key, and walking
+ * every entry with the iterator, are measured too, as well as lookups in the
+ * hash index against lookups in the same list once frozen. */
+
+#include "bench.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "lhttp_list.h"
+
+#define WORK (1u << 22)
+
+/* The former list: a sentinel head, one node and two copies per entry, and
+ * a linear `strcmp` scan for every operation */
+struct linked_node
+{
+	char *key;
+	char *value;
+	struct linked_node *next;
+};
+
+static struct linked_node *
+linked_find(struct linked_node *head, const char *key)
+{
+	struct linked_node *node;
+
+	for (node = head->next; node != NULL; node = node->next)
+	{
+		if (strcmp(node->key, key) == 0)
+			return node;
+	}
+
+	return NULL;
+}
+
+static void linked_add(struct linked_node *head, const char *key, const char *v)
+{
+	struct linked_node *node, *tail = head;
+
+	if (linked_find(head, key) != NULL)
+		return;
+
+	while (tail->next != NULL)
+		tail = tail->next;
+
+	node        = calloc(1, sizeof(*node));
+	node->key   = strdup(key);
+	node->value = strdup(v);
+	tail->next  = node;
+}
+
+static void linked_remove(struct linked_node *head, const char *key)
+{
+	struct linked_node *prev = head, *node = head->next;
+
+	for (; node != NULL; prev = node, node = node->next)
+	{
+		if (strcmp(node->key, key) == 0)
+		{
+			prev->next = node->next;
+			free(node->key);
+			free(node->value);
+			free(node);
+			return;
+		}
+	}
+}
+
+static char (*keys)[24];
+
+static void build(size_t n, size_t rounds)
+{
+	lhttp_list_field_t *fields = malloc(n * sizeof(*fields));
+	lhttp_list_t list;
+	char name[64];
+	uint64_t r;
+	size_t i;
+	double t;
+
+	for (i = 0; i < n; i++)
+	{
+		fields[i].name      = keys[i];
+		fields[i].name_len  = strlen(keys[i]);
+		fields[i].value     = "value";
+		fields[i].value_len = 5;
+	}
+
+	// One operation is one entry added
+	t = bench_now();
+	for (r = 0; r < rounds; r++)
+	{
+		lhttp_list_init(&list);
+		for (i = 0; i < n; i++)
+			lhttp_list_add_n(&list, keys[i], fields[i].name_len, "value", 5);
+		BENCH_KEEP(list.__size);
+		lhttp_list_free(&list);
+	}
+	snprintf(name, sizeof(name), "build/add/%zu", n);
+	bench_report(name, rounds * n, 0, bench_now() - t);
+
+	t = bench_now();
+	for (r = 0; r < rounds; r++)
+	{
+		lhttp_list_init(&list);
+		lhttp_list_add_all(&list, fields, n);
+		BENCH_KEEP(list.__size);
+		lhttp_list_free(&list);
+	}
+	snprintf(name, sizeof(name), "build/add_all/%zu", n);
+	bench_report(name, rounds * n, 0, bench_now() - t);
+
+	free(fields);
+}
+
+static void iterate(size_t n, size_t rounds)
+{
+	lhttp_list_t list;
+	lhttp_list_iter_t iter;
+	const char *key, *value;
+	size_t key_len, value_len, sum = 0;
+	char name[64];
+	uint64_t r;
+	size_t i;
+	double t;
+
+	lhttp_list_init(&list);
+	for (i = 0; i < n; i++)
+		lhttp_list_add(&list, keys[i], "value");
+
+	// One operation is one entry visited
+	t = bench_now();
+	for (r = 0; r < rounds; r++)
+	{
+		lhttp_list_iter_begin(&list, &iter);
+		while (lhttp_list_iter_next(&iter, &key, &key_len, &value, &value_len))
+			sum += key[key_len - 1] + value[value_len - 1];
+	}
+	BENCH_KEEP(sum);
+	snprintf(name, sizeof(name), "iterate/%zu", n);
+	bench_report(name, rounds * n, 0, bench_now() - t);
+
+	lhttp_list_free(&list);
+}
+
+static void lookup(size_t n, size_t rounds)
+{
+	lhttp_list_t list;
+	const char *value;
+	char name[64];
+	size_t *lens = malloc(n * sizeof(*lens));
+	uint64_t r;
+	size_t i, pass;
+	double t;
+
+	lhttp_list_init(&list);
+	for (i = 0; i < n; i++)
+	{
+		lens[i] = strlen(keys[i]);
+		lhttp_list_add(&list, keys[i], "value");
+	}
+
+	// One operation is one lookup, first in the index, then frozen
+	for (pass = 0; pass < 2; pass++)
+	{
+		t = bench_now();
+		for (r = 0; r < rounds; r++)
+		{
+			for (i = 0; i < n; i++)
+			{
+				lhttp_list_get_n(&list, keys[i], lens[i], &value, NULL);
+				BENCH_KEEP(value);
+			}
+		}
+		snprintf(
+		    name,
+		    sizeof(name),
+		    "lookup/%s/%zu",
+		    pass == 0 ? "index" : "frozen",
+		    n
+		);
+		bench_report(name, rounds * n, 0, bench_now() - t);
+
+		lhttp_list_freeze(&list);
+	}
+
+	lhttp_list_free(&list);
+	free(lens);
+}
+
+static void run(size_t n)
+{
+	size_t rounds = WORK / n / (n < 256 ? 1 : n / 64);
+	char name[64], *value;
+	uint64_t r;
+	size_t i;
+	double t;
+
+	t = bench_now();
+	for (r = 0; r < rounds; r++)
+	{
+		struct linked_node *head = calloc(1, sizeof(*head));
+
+		for (i = 0; i < n; i++)
+			linked_add(head, keys[i], "value");
+		for (i = 0; i < n; i++)
+			BENCH_KEEP(linked_find(head, keys[i]));
+		for (i = 0; i < n; i++)
+			linked_remove(head, keys[i]);
+
+		free(head);
+	}
+	snprintf(name, sizeof(name), "linked/%zu", n);
+	bench_report(name, rounds * n, 0, bench_now() - t);
+
+	t = bench_now();
+	for (r = 0; r < rounds; r++)
+	{
+		lhttp_list_t list;
+
+		lhttp_list_init(&list);
+		for (i = 0; i < n; i++)
+			lhttp_list_add(&list, keys[i], "value");
+		for (i = 0; i < n; i++)
+		{
+			lhttp_list_get(&list, keys[i], &value);
+			BENCH_KEEP(value);
+		}
+		for (i = 0; i < n; i++)
+			lhttp_list_remove(&list, keys[i]);
+
+		lhttp_list_free(&list);
+	}
+	snprintf(name, sizeof(name), "hash/%zu", n);
+	bench_report(name, rounds * n, 0, bench_now() - t);
+
+	t = bench_now();
+	for (r = 0; r < rounds; r++)
+	{
+		lhttp_list_t list;
+		const char *view;
+		size_t len;
+
+		lhttp_list_init(&list);
+		for (i = 0; i < n; i++)
+		{
+			len = strlen(keys[i]);
+			lhttp_list_add_borrowed(&list, keys[i], len, "value", 5);
+		}
+		for (i = 0; i < n; i++)
+		{
+			lhttp_list_get_n(&list, keys[i], strlen(keys[i]), &view, &len);
+			BENCH_KEEP(view);
+		}
+		for (i = 0; i < n; i++)
+			lhttp_list_remove_n(&list, keys[i], strlen(keys[i]));
+
+		lhttp_list_free(&list);
+	}
+	snprintf(name, sizeof(name), "hash/borrowed/%zu", n);
+	bench_report(name, rounds * n, 0, bench_now() - t);
+
+	build(n, rounds);
+	iterate(n, rounds);
+	lookup(n, rounds);
+}
+
+int main(void)
+{
+	size_t i;
+
+	keys = malloc(1024 * sizeof(*keys));
+	for (i = 0; i < 1024; i++)
+		snprintf(keys[i], sizeof(keys[i]), "X-Header-%zu", i);
+
+	// One operation is an add, a lookup and a remove of the same key
+	run(8);
+	run(64);
+	run(1024);
+
+	free(keys);
+
+	return 0;
+}
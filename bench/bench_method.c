@@ -0,0 +1,144 @@
+/* Copyright (c) 2024 libhttp. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/* Method and version decoding: word compares against a `strncmp` chain, for
+ * each of the nine standard methods and for a mix of all of them. */
+
+#include "bench.h"
+
+#include <string.h>
+
+#include "lhttp_token.h"
+
+#define ITERATIONS 20000000u
+
+static const char *methods[] = {
+    "GET ",
+    "HEAD ",
+    "POST ",
+    "PUT ",
+    "DELETE ",
+    "CONNECT ",
+    "OPTIONS ",
+    "TRACE ",
+    "PATCH ",
+};
+
+#define METHOD_COUNT (sizeof(methods) / sizeof(methods[0]))
+
+/* What a decoder without word compares typically looks like */
+static lhttp_method_t strncmp_decode(const char *m, size_t len)
+{
+	static const char *names[] = {
+	    "GET",
+	    "HEAD",
+	    "POST",
+	    "PUT",
+	    "DELETE",
+	    "CONNECT",
+	    "OPTIONS",
+	    "TRACE",
+	    "PATCH",
+	};
+	size_t i;
+
+	for (i = 0; i < METHOD_COUNT; i++)
+	{
+		if (strlen(names[i]) == len && strncmp(names[i], m, len) == 0)
+			return (lhttp_method_t)i;
+	}
+
+	return LHTTP_METHOD_EXTENSION;
+}
+
+static lhttp_version_t strncmp_version(const char *v, size_t len)
+{
+	if (len == 8 && strncmp(v, "HTTP/1.1", 8) == 0)
+		return LHTTP_VERSION_1_1;
+
+	if (len == 8 && strncmp(v, "HTTP/1.0", 8) == 0)
+		return LHTTP_VERSION_1_0;
+
+	return LHTTP_VERSION_INVALID;
+}
+
+static void run_method(const char *label, size_t first, size_t count)
+{
+	char name[64];
+	uint64_t i;
+	double t;
+
+	t = bench_now();
+	for (i = 0; i < ITERATIONS; i++)
+	{
+		const char *m = methods[first + i % count];
+
+		BENCH_KEEP(m);
+		BENCH_KEEP(strncmp_decode(m, strchr(m, ' ') - m));
+	}
+	snprintf(name, sizeof(name), "strncmp/%s", label);
+	bench_report(name, ITERATIONS, 0, bench_now() - t);
+
+	t = bench_now();
+	for (i = 0; i < ITERATIONS; i++)
+	{
+		const char *m = methods[first + i % count];
+
+		BENCH_KEEP(m);
+		BENCH_KEEP(__lhttp_method_decode(m, strchr(m, ' ') - m));
+	}
+	snprintf(name, sizeof(name), "word/%s", label);
+	bench_report(name, ITERATIONS, 0, bench_now() - t);
+}
+
+int main(void)
+{
+	const char *version = "HTTP/1.1";
+	lhttp_version_t decoded;
+	size_t k;
+	uint64_t i;
+	double t;
+
+	// The method length is found the same way in both cases, so the
+	// difference between the two is the decoding itself
+	for (k = 0; k < METHOD_COUNT; k++)
+	{
+		char label[16];
+		int len = (int)strcspn(methods[k], " ");
+
+		snprintf(label, sizeof(label), "%.*s", len, methods[k]);
+		run_method(label, k, 1);
+	}
+
+	run_method("mixed", 0, METHOD_COUNT);
+
+	t = bench_now();
+	for (i = 0; i < ITERATIONS; i++)
+	{
+		BENCH_KEEP(version);
+		BENCH_KEEP(strncmp_version(version, 8));
+	}
+	bench_report("strncmp/HTTP/1.1", ITERATIONS, 0, bench_now() - t);
+
+	t = bench_now();
+	for (i = 0; i < ITERATIONS; i++)
+	{
+		BENCH_KEEP(version);
+		BENCH_KEEP(__lhttp_version_decode(version, 8, &decoded));
+	}
+	bench_report("word/HTTP/1.1", ITERATIONS, 0, bench_now() - t);
+
+	return 0;
+}
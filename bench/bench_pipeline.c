@@ -0,0 +1,108 @@
+/* Copyright (c) 2024 libhttp. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/* Pipelined parsing: 16 GET requests per read buffer, walked in place with
+ * `lhttp_request_parse_stream` in borrowed and copy mode. In copy mode, the
+ * request is either initialized for every message or reset between them. */
+
+#include "bench.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "lhttp_request.h"
+
+#define ITERATIONS 200000u
+#define PIPELINE   16
+
+static const char *get_request = "GET /index.html?page=%d HTTP/1.1\r\n"
+                                 "Host: www.example.com\r\n"
+                                 "User-Agent: bench/1.0\r\n"
+                                 "Accept: text/html,application/xhtml+xml\r\n"
+                                 "Accept-Encoding: gzip, deflate\r\n"
+                                 "Connection: keep-alive\r\n"
+                                 "\r\n";
+
+enum mode
+{
+	MODE_BORROWED,
+	MODE_INIT,
+	MODE_RESET,
+};
+
+static void run(const char *name, const char *stream, size_t len, int mode)
+{
+	lhttp_request_t request;
+	size_t consumed;
+	uint64_t i;
+	double t;
+
+	if (mode == MODE_RESET)
+		lhttp_request_init(&request, 1024);
+
+	t = bench_now();
+	for (i = 0; i < ITERATIONS; i++)
+	{
+		const char *p   = stream;
+		const char *end = stream + len;
+
+		while (p < end)
+		{
+			if (mode == MODE_BORROWED)
+				lhttp_request_init_borrowed(&request, end - p);
+			else if (mode == MODE_INIT)
+				lhttp_request_init(&request, 1024);
+			else
+				lhttp_request_reset(&request);
+
+			if (lhttp_request_parse_stream(&request, p, end - p, &consumed) !=
+			    0)
+			{
+				fprintf(stderr, "%s: parsing failed\n", name);
+				exit(1);
+			}
+
+			BENCH_KEEP(request.__header_count);
+			if (mode != MODE_RESET)
+				lhttp_request_free(&request);
+
+			p += consumed;
+		}
+	}
+	t = bench_now() - t;
+	bench_report(name, ITERATIONS * PIPELINE, ITERATIONS * len, t);
+
+	if (mode == MODE_RESET)
+		lhttp_request_free(&request);
+}
+
+int main(void)
+{
+	char stream[PIPELINE * 256];
+	size_t len = 0;
+	int i;
+
+	for (i = 0; i < PIPELINE; i++)
+	{
+		len +=
+		    snprintf(stream + len, sizeof(stream) - len, get_request, i % 10);
+	}
+
+	run("pipeline/borrowed", stream, len, MODE_BORROWED);
+	run("pipeline/copy/init", stream, len, MODE_INIT);
+	run("pipeline/copy/reset", stream, len, MODE_RESET);
+
+	return 0;
+}
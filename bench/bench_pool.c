@@ -0,0 +1,141 @@
+/* Copyright (c) 2024 libhttp. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/* Header lists built and torn down by 1 to N threads at once, allocating
+ * with libc against a shared block pool with one cache per thread. Every
+ * thread adds and removes the same number of headers, so the aggregate
+ * throughput shows how each allocator scales. Usage: bench_pool [threads],
+ * the default being the number of online CPUs. */
+
+#include "bench.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "lhttp_list.h"
+#include "lhttp_pool.h"
+
+#define ITERATIONS 100000u
+#define HEADERS    16
+
+static char names[HEADERS][16];
+
+static lhttp_pool_t pool;
+
+static pthread_barrier_t barrier;
+
+/**
+ * @brief Worker body: build and tear down a list ITERATIONS times
+ *
+ * @param arg Non-NULL to allocate from the pool
+ */
+static void *work(void *arg)
+{
+	const lhttp_allocator_t *allocator = NULL;
+	lhttp_pool_cache_t cache;
+	lhttp_list_t list;
+	uint64_t i;
+	size_t j;
+
+	if (arg != NULL)
+	{
+		lhttp_pool_cache_init(&cache, &pool);
+		allocator = lhttp_pool_cache_allocator(&cache);
+	}
+
+	pthread_barrier_wait(&barrier);
+
+	for (i = 0; i < ITERATIONS; i++)
+	{
+		lhttp_list_init_with_allocator(&list, allocator);
+
+		for (j = 0; j < HEADERS; j++)
+			lhttp_list_add(&list, names[j], "some header value");
+
+		for (j = 0; j < HEADERS; j++)
+			lhttp_list_remove(&list, names[j]);
+
+		BENCH_KEEP(list.__size);
+		lhttp_list_free(&list);
+	}
+
+	if (arg != NULL)
+		lhttp_pool_cache_free(&cache);
+
+	return NULL;
+}
+
+static void run(const char *label, size_t threads, bool use_pool)
+{
+	pthread_t *ids = malloc(threads * sizeof(*ids));
+	char name[64];
+	size_t i;
+	double t;
+
+	// The main thread joins the barrier so that thread creation is not timed
+	pthread_barrier_init(&barrier, NULL, threads + 1);
+
+	for (i = 0; i < threads; i++)
+		pthread_create(&ids[i], NULL, work, use_pool ? &pool : NULL);
+
+	pthread_barrier_wait(&barrier);
+	t = bench_now();
+
+	for (i = 0; i < threads; i++)
+		pthread_join(ids[i], NULL);
+
+	// One operation is one add or one remove, counted over all threads
+	snprintf(name, sizeof(name), "%s/%zu threads", label, threads);
+	bench_report(
+	    name,
+	    (uint64_t)threads * ITERATIONS * HEADERS * 2,
+	    0,
+	    bench_now() - t
+	);
+
+	pthread_barrier_destroy(&barrier);
+	free(ids);
+}
+
+int main(int argc, char *argv[])
+{
+	long cpus = argc > 1 ? atol(argv[1]) : sysconf(_SC_NPROCESSORS_ONLN);
+	size_t max = cpus > 0 ? (size_t)cpus : 1;
+	size_t i, threads;
+
+	for (i = 0; i < HEADERS; i++)
+		snprintf(names[i], sizeof(names[i]), "X-Header-%zu", i);
+
+	// Key and value copies fit in one 64-byte block
+	lhttp_pool_init(&pool, 64, 0, NULL);
+
+	for (threads = 1;; threads *= 2)
+	{
+		if (threads > max)
+			threads = max;
+
+		run("malloc", threads, false);
+		run("pool", threads, true);
+
+		if (threads == max)
+			break;
+	}
+
+	lhttp_pool_free(&pool);
+
+	return 0;
+}
@@ -0,0 +1,172 @@
+/* Copyright (c) 2024 libhttp. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/* Request line boundary detection: the original four-`strstr` approach
+ * against the single forward sweep, for every scanner implementation. */
+
+#include "bench.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "lhttp_scan.h"
+
+struct marks
+{
+	const char *method_end;
+	const char *uri_start;
+	const char *uri_end;
+	const char *version_start;
+	const char *line_end;
+};
+
+/* The request line parser as it was before the scanner, minus the markers */
+static int strstr_path(const char *buf, struct marks *m)
+{
+	m->line_end = strstr(buf, "\r\n");
+	if (m->line_end == NULL)
+		return -1;
+
+	m->method_end = strstr(buf, " ");
+	if (m->method_end == NULL)
+		return -1;
+
+	m->uri_start = m->method_end + 1;
+	for (; *m->uri_start == ' '; m->uri_start++)
+		;
+
+	m->uri_end = strstr(m->uri_start, " ");
+	if (m->uri_end == NULL)
+		return -1;
+
+	m->version_start = m->uri_end + 1;
+	for (; *m->version_start == ' '; m->version_start++)
+		;
+
+	return strstr(m->version_start, "\r\n") == NULL ? -1 : 0;
+}
+
+static int
+sweep_path(__lhttp_scan_fn scan, const char *p, size_t len, struct marks *m)
+{
+	const char *end = p + len;
+
+	m->method_end = scan(p, end, " \r\n", 3);
+	if (m->method_end == end || *m->method_end != ' ')
+		return -1;
+
+	for (p = m->method_end; p < end && *p == ' '; p++)
+		;
+
+	m->uri_start = p;
+	m->uri_end   = scan(p, end, " \r\n", 3);
+	if (m->uri_end == end || *m->uri_end != ' ')
+		return -1;
+
+	for (p = m->uri_end; p < end && *p == ' '; p++)
+		;
+
+	m->version_start = p;
+	m->line_end      = scan(p, end, " \r\n", 3);
+
+	return (end - m->line_end < 2 || *m->line_end != '\r') ? -1 : 0;
+}
+
+static char *make_line(size_t uri_len, size_t *len)
+{
+	const char *tail = " HTTP/1.1\r\n";
+	char *line       = malloc(4 + uri_len + strlen(tail) + 1);
+	size_t i;
+
+	if (line == NULL)
+	{
+		fprintf(stderr, "bench_request_line: out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+
+	memcpy(line, "GET /", 5);
+	for (i = 1; i < uri_len; i++)
+		line[4 + i] = "abcdefghijklmnopqrstuvwxyz0123456789/-_."[i % 40];
+
+	strcpy(line + 4 + uri_len, tail);
+	*len = strlen(line);
+
+	return line;
+}
+
+static void run(const char *label, size_t uri_len)
+{
+	size_t len;
+	char *line     = make_line(uri_len, &len);
+	uint64_t iters = (uint64_t)(256u << 20) / len + 1;
+	struct marks m = {0};
+	char name[64];
+	uint64_t i;
+	double t;
+
+	struct
+	{
+		const char *name;
+		__lhttp_scan_fn fn;
+		int available;
+	} impls[] = {
+	    {"scalar", __lhttp_scan_find_scalar, 1},
+#ifdef LHTTP_SCAN_X86
+	    {"sse2",   __lhttp_scan_find_sse2,  __lhttp_scan_has_sse2() },
+	    {"sse4.2", __lhttp_scan_find_sse42, __lhttp_scan_has_sse42()},
+	    {"avx2",   __lhttp_scan_find_avx2,  __lhttp_scan_has_avx2() },
+#endif
+	};
+
+	printf("-- %s (%zu bytes)\n", label, len);
+
+	t = bench_now();
+	for (i = 0; i < iters; i++)
+	{
+		BENCH_KEEP(line);
+		BENCH_KEEP(strstr_path(line, &m));
+	}
+	snprintf(name, sizeof(name), "strstr");
+	bench_report(name, iters, iters * len, bench_now() - t);
+
+	for (size_t k = 0; k < sizeof(impls) / sizeof(impls[0]); k++)
+	{
+		if (!impls[k].available)
+			continue;
+
+		t = bench_now();
+		for (i = 0; i < iters; i++)
+		{
+			BENCH_KEEP(line);
+			BENCH_KEEP(sweep_path(impls[k].fn, line, len, &m));
+		}
+		snprintf(name, sizeof(name), "sweep/%s", impls[k].name);
+		bench_report(name, iters, iters * len, bench_now() - t);
+	}
+
+	free(line);
+}
+
+int main(void)
+{
+	printf("runtime scanner: %s\n", __lhttp_scan_impl_name());
+
+	run("short", 1);
+	run("typical", 64);
+	run("long", 1024);
+	run("huge", 8192);
+
+	return 0;
+}
@@ -0,0 +1,274 @@
+/* Copyright (c) 2024 libhttp. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/* Percent-decoding of corpora shaped like the request-targets of a CDN:
+ * plain asset paths, long paths with a few encoded spaces, non-ASCII paths
+ * where almost every byte is escaped, and form-encoded query strings. Each
+ * corpus is decoded in place by `lhttp_uri_decode` and by a byte-at-a-time
+ * loop, both working on a fresh copy for every pass. Paths are then
+ * normalized in place by `lhttp_uri_normalize_path`, against the copy into
+ * a new allocation that routers commonly make. */
+
+#include "bench.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lhttp_uri.h"
+
+#define WORK (256u << 20)
+
+static const char *plain[] = {
+    "/static/js/main.7f3c2a1b.chunk.js",
+    "/assets/images/hero-banner-1920x1080.webp",
+    "/api/v2/catalog/products/1234567/reviews",
+    "/fonts/inter/Inter-SemiBold.woff2",
+};
+
+static const char *spaced[] = {
+    "/media/uploads/2024/03/Annual%20Report%20Q1%20Final%20Version.pdf",
+    "/downloads/Product%20Brochure%20(English)/brochure-v12-print.pdf",
+    "/videos/season-01/episode-04/The%20Long%20Way%20Home%201080p.mp4",
+    "/docs/guides/getting-started/installing%20on%20linux.html",
+};
+
+static const char *utf8[] = {
+    "/wiki/%E6%9D%B1%E4%BA%AC%E9%83%BD/%E6%AD%B4%E5%8F%B2",
+    "/%D0%BA%D0%B0%D1%82%D0%B0%D0%BB%D0%BE%D0%B3/"
+    "%D0%BA%D0%BD%D0%B8%D0%B3%D0%B8",
+    "/search/%EC%84%9C%EC%9A%B8%20%EB%A7%9B%EC%A7%91",
+    "/tags/caf%C3%A9-cr%C3%A8me-br%C3%BBl%C3%A9e",
+};
+
+static const char *form[] = {
+    "q=best+running+shoes+for+flat+feet&sort=price_asc&page=2&size=48",
+    "utm_source=newsletter&utm_medium=email&utm_campaign=spring+sale+2024",
+    "redirect=https%3A%2F%2Fexample.com%2Faccount%3Ftab%3Dorders&lang=en",
+    "name=Jane+Doe&email=jane.doe%40example.com&msg=Hello%2C+world%21",
+};
+
+static const char *dotted[] = {
+    "/static/js/../css/./main.css",
+    "//assets///images/./hero-banner.webp",
+    "/api/v2/../v3/catalog/./products/",
+    "/fonts/inter/./../roboto/Roboto.woff2",
+};
+
+/**
+ * @brief Reference decoder: one byte at a time, with the branches a naive
+ * implementation would take
+ */
+static int
+naive_decode(char *data, size_t len, lhttp_uri_decode_mode_t mode, size_t *n)
+{
+	size_t r, w = 0;
+	int hi, lo;
+
+	for (r = 0; r < len; r++)
+	{
+		char c = data[r];
+
+		if (c == '+' && mode == LHTTP_URI_DECODE_FORM)
+		{
+			c = ' ';
+		}
+		else if (c == '%')
+		{
+			if (len - r < 3)
+				return -1;
+
+			hi = data[r + 1];
+			lo = data[r + 2];
+			hi = hi <= '9' ? hi - '0' : (hi | 0x20) - 'a' + 10;
+			lo = lo <= '9' ? lo - '0' : (lo | 0x20) - 'a' + 10;
+			if (hi < 0 || hi > 15 || lo < 0 || lo > 15 || (hi | lo) == 0)
+				return -1;
+
+			c = (char)(hi << 4 | lo);
+			r += 2;
+
+			if (mode == LHTTP_URI_DECODE_PATH && (c == '/' || c == '\\'))
+				return -1;
+		}
+
+		data[w++] = c;
+	}
+
+	*n = w;
+	return 0;
+}
+
+/**
+ * @brief Reference normalizer: the path is copied segment by segment into a
+ * new buffer, which replaces it
+ */
+static int copy_normalize(char *path, size_t len, size_t *n)
+{
+	char *out = malloc(len + 1);
+	size_t r = 0, w = 0, e;
+	bool dot, dots;
+
+	if (out == NULL)
+		return -1;
+
+	while (r < len)
+	{
+		while (r < len && path[r] == '/')
+			r++;
+
+		for (e = r; e < len && path[e] != '/'; e++)
+			;
+
+		dot  = e - r == 1 && path[r] == '.';
+		dots = e - r == 2 && path[r] == '.' && path[r + 1] == '.';
+
+		if (dots)
+		{
+			if (w == 0)
+			{
+				free(out);
+				return -1;
+			}
+
+			while (out[--w] != '/')
+				;
+		}
+		else if (!dot && e > r)
+		{
+			out[w++] = '/';
+			memcpy(out + w, path + r, e - r);
+			w += e - r;
+		}
+
+		// A path ending in a directory keeps its trailing slash
+		if (e == len && (dot || dots || e == r))
+			out[w++] = '/';
+
+		r = e;
+	}
+
+	memcpy(path, out, w);
+	free(out);
+
+	*n = w;
+	return 0;
+}
+
+static void normalize(const char *label, const char **corpus)
+{
+	char scratch[256];
+	size_t lens[4], i, n;
+	uint64_t iters = WORK / 256, k;
+	double t;
+
+	for (i = 0; i < 4; i++)
+		lens[i] = strlen(corpus[i]);
+
+	printf("-- %s\n", label);
+
+	t = bench_now();
+	for (k = 0; k < iters; k++)
+	{
+		i = k & 3;
+		memcpy(scratch, corpus[i], lens[i]);
+		copy_normalize(scratch, lens[i], &n);
+		BENCH_KEEP(n);
+	}
+	bench_report("normalize/copy", iters, 0, bench_now() - t);
+
+	t = bench_now();
+	for (k = 0; k < iters; k++)
+	{
+		i = k & 3;
+		memcpy(scratch, corpus[i], lens[i]);
+		lhttp_uri_normalize_path(scratch, lens[i], &n);
+		BENCH_KEEP(n);
+	}
+	bench_report("normalize/lhttp", iters, 0, bench_now() - t);
+}
+
+typedef int (*decode_fn)(char *, size_t, lhttp_uri_decode_mode_t, size_t *);
+
+static void run(
+    const char *label,
+    const char **corpus,
+    lhttp_uri_decode_mode_t mode,
+    size_t repeat
+)
+{
+	char *source, *scratch;
+	size_t i, len = 0, n;
+	uint64_t iters, k;
+	char name[64];
+	double t;
+
+	const struct
+	{
+		const char *name;
+		decode_fn fn;
+	} impls[] = {
+	    {"naive", naive_decode},
+	    {"lhttp", lhttp_uri_decode},
+	};
+
+	// Long targets are built by joining the corpus, `repeat` times over
+	for (i = 0; i < 4 * repeat; i++)
+		len += strlen(corpus[i % 4]);
+
+	source  = malloc(len);
+	scratch = malloc(len);
+
+	for (i = 0, n = 0; i < 4 * repeat; i++)
+	{
+		memcpy(source + n, corpus[i % 4], strlen(corpus[i % 4]));
+		n += strlen(corpus[i % 4]);
+	}
+
+	iters = WORK / len + 1;
+	printf("-- %s (%zu bytes)\n", label, len);
+
+	for (i = 0; i < sizeof(impls) / sizeof(impls[0]); i++)
+	{
+		t = bench_now();
+		for (k = 0; k < iters; k++)
+		{
+			memcpy(scratch, source, len);
+			impls[i].fn(scratch, len, mode, &n);
+			BENCH_KEEP(n);
+		}
+		snprintf(name, sizeof(name), "decode/%s", impls[i].name);
+		bench_report(name, iters, iters * len, bench_now() - t);
+	}
+
+	free(source);
+	free(scratch);
+}
+
+int main(void)
+{
+	run("plain paths", plain, LHTTP_URI_DECODE_PATH, 1);
+	run("plain paths x16", plain, LHTTP_URI_DECODE_PATH, 16);
+	run("encoded spaces", spaced, LHTTP_URI_DECODE_PATH, 1);
+	run("encoded spaces x16", spaced, LHTTP_URI_DECODE_PATH, 16);
+	run("utf-8 paths", utf8, LHTTP_URI_DECODE_PATH, 1);
+	run("utf-8 paths x16", utf8, LHTTP_URI_DECODE_PATH, 16);
+	run("form queries", form, LHTTP_URI_DECODE_FORM, 1);
+	run("form queries x16", form, LHTTP_URI_DECODE_FORM, 16);
+	normalize("normal paths", plain);
+	normalize("dotted paths", dotted);
+
+	return 0;
+}
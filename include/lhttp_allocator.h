@@ -0,0 +1,60 @@
+/* include/lhttp_allocator.h
+ * 
+ * Copyright (c) 2024 libhttp. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef LIBHTTP_ALLOCATOR_H
+#define LIBHTTP_ALLOCATOR_H 1
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Memory allocator used by the library for every allocation
+ * 
+ * @note Every function gets the user context `ctx` as its first argument.
+ * `free_fn` and `realloc_fn` are also given the size the block was allocated
+ * with, so that allocators without per-block headers (arenas, pools) can be
+ * plugged in. `free_fn` and `realloc_fn` are never called with NULL. The
+ * members carry a `_fn` suffix so that allocator macros such as
+ * `#define malloc my_malloc` in the caller's code do not rename them.
+ */
+typedef struct lhttp_allocator_s
+{
+	/* Allocate `size` bytes, or return NULL on failure */
+	void *(*malloc_fn)(void *ctx, size_t size);
+
+	/* Resize `ptr` from `old_size` to `new_size` bytes, keeping its content,
+	or return NULL on failure and leave `ptr` untouched */
+	void *(*realloc_fn)(void *ctx, void *ptr, size_t old_size, size_t new_size);
+
+	/* Release `ptr`, which was allocated with `size` bytes */
+	void (*free_fn)(void *ctx, void *ptr, size_t size);
+
+	/* User context passed to every function */
+	void *ctx;
+} lhttp_allocator_t;
+
+/* Allocator used when none is given, backed by the libc `malloc` family */
+extern const lhttp_allocator_t lhttp_allocator_libc;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LIBHTTP_ALLOCATOR_H
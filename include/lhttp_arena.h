@@ -0,0 +1,132 @@
+/* include/lhttp_arena.h
+ * 
+ * Copyright (c) 2024 libhttp. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef LIBHTTP_ARENA_H
+#define LIBHTTP_ARENA_H 1
+
+#include <stddef.h>
+
+#include <lhttp_allocator.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Alignment of every block handed out by the arena */
+#ifndef LHTTP_ARENA_ALIGN
+#define LHTTP_ARENA_ALIGN 16
+#endif
+
+/* Default size of the chunks the arena grows by */
+#ifndef LHTTP_ARENA_CHUNK_SIZE
+#define LHTTP_ARENA_CHUNK_SIZE 4096
+#endif
+
+/**
+ * @brief Private header of a chunk of arena memory, followed by its data
+ */
+struct __lhttp_arena_chunk_s
+{
+	/* Next chunk, kept across resets to be reused */
+	struct __lhttp_arena_chunk_s *__next;
+
+	/* Amount of data bytes in the chunk */
+	size_t __size;
+};
+
+/**
+ * @brief Bump allocator that frees everything at once
+ * 
+ * @note Blocks are carved out of chunks obtained from a backing allocator.
+ * Freeing a block only gives memory back when it is the last one allocated;
+ * otherwise memory is reclaimed by `lhttp_arena_reset` or `lhttp_arena_free`.
+ */
+typedef struct lhttp_arena_s
+{
+	/* Private fields. Used by method impls. */
+
+	lhttp_allocator_t __allocator;         // vtable allocating from the arena
+	const lhttp_allocator_t *__backing;    // allocator of the chunks
+	size_t __chunk_size;                   // data size of regular chunks
+	struct __lhttp_arena_chunk_s *__first; // first chunk, NULL until used
+	struct __lhttp_arena_chunk_s *__chunk; // chunk being carved
+	char *__ptr;                           // next free byte in `__chunk`
+	char *__end;                           // end of `__chunk`
+} lhttp_arena_t;
+
+/**
+ * @brief Initialize a `lhttp_arena_t` structure
+ * 
+ * @param arena A pointer to a `lhttp_arena_t` structure
+ * @param chunk_size Size of the chunks the arena grows by, or 0 for
+ * `LHTTP_ARENA_CHUNK_SIZE`
+ * @param backing Allocator of the chunks, or NULL for `lhttp_allocator_libc`
+ * @return 0 on success, -1 on failure
+ * 
+ * @note Nothing is allocated until the first block is requested.
+ */
+int lhttp_arena_init(
+    lhttp_arena_t *arena,
+    size_t chunk_size,
+    const lhttp_allocator_t *backing
+);
+
+/**
+ * @brief Allocate `size` bytes from `arena`
+ * 
+ * @param arena A pointer to an initialized `lhttp_arena_t` structure
+ * @param size Amount of bytes to allocate
+ * @return A block aligned to `LHTTP_ARENA_ALIGN`, or NULL on failure
+ * 
+ * @note A block larger than the chunk size gets a chunk of its own.
+ */
+void *lhttp_arena_alloc(lhttp_arena_t *arena, size_t size);
+
+/**
+ * @brief Get an allocator that allocates from `arena`
+ * 
+ * @param arena A pointer to an initialized `lhttp_arena_t` structure
+ * @return An allocator to pass to `lhttp_request_init_with_allocator` or
+ * `lhttp_list_init_with_allocator`, valid as long as the arena
+ */
+const lhttp_allocator_t *lhttp_arena_allocator(lhttp_arena_t *arena);
+
+/**
+ * @brief Release every block of `arena` at once, keeping its chunks
+ * 
+ * @param arena A pointer to an initialized `lhttp_arena_t` structure
+ * 
+ * @note This is O(1): the arena starts carving its first chunk again and
+ * reuses the following chunks as it grows. Every block allocated so far is
+ * invalidated, including the memory of requests and lists using the arena.
+ */
+void lhttp_arena_reset(lhttp_arena_t *arena);
+
+/**
+ * @brief Free every chunk of `arena`
+ * 
+ * @param arena A pointer to an initialized `lhttp_arena_t` structure
+ * 
+ * @note The arena can be used again afterwards, as if freshly initialized.
+ */
+void lhttp_arena_free(lhttp_arena_t *arena);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LIBHTTP_ARENA_H
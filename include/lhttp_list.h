@@ -29,6 +29,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <lhttp_allocator.h>
+
 #ifdef DEBUG
 #include <stdio.h>
 #endif
@@ -66,6 +68,9 @@ typedef enum lhttp_list_state_e
 	/* The list was once ready but it got free'd and not available for list 
 	operations. */
 	LHTTP_LIST_UNAVAILABLE,
+
+	/* The list was frozen by `lhttp_list_freeze` and only accepts lookups */
+	LHTTP_LIST_FROZEN,
 } lhttp_list_state_t;
 
 /**
@@ -102,46 +107,186 @@ typedef enum lhttp_list_error_e
 	LHTTP_LIST_ERROR_VALUE_NULL,
 
 	/* Generic and/or unknown error */
-	LHTTP_LIST_UNKNOWN_ERROR
+	LHTTP_LIST_UNKNOWN_ERROR,
+
+	/* The operation is only allowed on an empty list */
+	LHTTP_LIST_ERROR_NOT_EMPTY,
+
+	/* The list is frozen and cannot be modified */
+	LHTTP_LIST_ERROR_FROZEN
 } lhttp_list_error_t;
 
 /**
- * @brief Private structure to store key-value string pairs of singly-linked list
+ * @brief HTTP list flags to select the behavior of a list
+ */
+typedef enum lhttp_list_flag_e
+{
+	/* Keys are compared ignoring ASCII case, as HTTP field names are */
+	LHTTP_LIST_CASE_INSENSITIVE = 1 << 0,
+
+	/* Repeated keys are kept in arrival order instead of being rejected */
+	LHTTP_LIST_MULTIMAP = 1 << 1,
+} lhttp_list_flag_t;
+
+/* Number of entries stored inside `lhttp_list_t` before spilling to the heap.
+ * An entry takes 32 bytes on LP64, so the 8 default entries take 256 bytes,
+ * plus 32 bytes for their hashes: `sizeof(lhttp_list_t)` is 376 bytes. */
+#ifndef LHTTP_LIST_INLINE_SIZE
+#define LHTTP_LIST_INLINE_SIZE 8
+#endif
+
+#if LHTTP_LIST_INLINE_SIZE < 1
+#error "LHTTP_LIST_INLINE_SIZE must be at least 1"
+#endif
+
+/**
+ * @brief Private structure to store a key-value string pair of the list
  */
-struct __lhttp_node_s
+struct __lhttp_entry_s
 {
-	/* Key member field is used for searching */
-	char *__key;
+	/* Key member field is used for searching, NULL once removed */
+	const char *__key;
 
 	/* Value member containing a value for the corresponding key */
-	char *__value;
+	const char *__value;
+
+	/* Length of the key */
+	uint32_t __key_len;
+
+	/* Length of the value */
+	uint32_t __value_len;
+
+	/* Hash of the key, computed once when the entry is added */
+	uint32_t __hash;
+
+	/* Index of the next entry with the same key plus one, 0 for the last */
+	uint32_t __next : 31;
+
+	/* Whether the strings are copies owned by the list */
+	uint32_t __owned : 1;
+};
+
+/**
+ * @brief Private header of a block of strings copied by
+ * `lhttp_list_add_all`, followed by the strings
+ */
+struct __lhttp_list_block_s
+{
+	/* Next block of the list */
+	struct __lhttp_list_block_s *__next;
+
+	/* Amount of string bytes in the block */
+	size_t __size;
+};
+
+/**
+ * @brief Private slot of the hash index of the list
+ */
+struct __lhttp_slot_s
+{
+	/* Hash of the key of the entry */
+	uint32_t __hash;
+
+	/* Index of the entry plus one, 0 for an empty slot */
+	uint32_t __index;
 
-	/* Next node in the list */
-	struct __lhttp_node_s *__next;
+	/* Index of the last entry of the key plus one, where a repeated key is
+	chained */
+	uint32_t __tail;
 };
 
 /**
- * @brief Singly-linked list structure to store HTTP lists
+ * @brief Hash map structure to store HTTP lists
+ * 
+ * @note Entries are stored contiguously in insertion order. The first
+ * `LHTTP_LIST_INLINE_SIZE` entries live inside the structure and are found by
+ * a linear scan of their hashes, which fit in one cache line by default, so
+ * a lookup only reads the line of the entry it matches. Past that, they move
+ * to the heap and an open addressing index (Robin Hood hashing) maps keys to
+ * them.
  */
 typedef struct lhttp_list_s
 {
-	/* Current state of the linked list after list operations */
+	/* Current state of the list after list operations */
 	lhttp_list_state_t state;
 
-	/* Error code of the linked list when list operations return errors */
+	/* Error code of the list when list operations return errors */
 	lhttp_list_error_t error;
 
-	/* An empty node that marks the head of the list (not the first item) */
-	struct __lhttp_node_s *__head;
+	/* Heap entries in insertion order, removed ones included until
+	compaction. NULL while the entries are inline. */
+	struct __lhttp_entry_s *__entries;
+
+	/* Number of used entries, removed ones included */
+	size_t __count;
+
+	/* Number of allocated entries */
+	size_t __capacity;
 
-	/* An empty node that marks the tail, or the last item, of the list */
-	struct __lhttp_node_s *__tail;
+	/* Hash index of the heap entries, NULL while the entries are inline.
+	Once frozen, the sorted keys from position 1 on. */
+	struct __lhttp_slot_s *__slots;
 
-	/* Number of existing nodes in the list */
+	/* Number of slots minus one, the number of slots is a power of two.
+	Once frozen, the number of sorted keys. */
+	size_t __mask;
+
+	/* Number of existing entries in the list */
 	size_t __size;
 
+	/* Allocator of the entries, the index and the copied strings */
+	const lhttp_allocator_t *__allocator;
+
+	/* Combination of `lhttp_list_flag_t` values */
+	uint32_t __flags;
+
+	/* Seed of the key hashes */
+	uint64_t __seed;
+
+	/* Blocks of strings copied by `lhttp_list_add_all` */
+	struct __lhttp_list_block_s *__blocks;
+
+	/* Hashes of the inline entries, scanned before the entries themselves */
+	uint32_t __small_hashes[LHTTP_LIST_INLINE_SIZE];
+
+	/* Inline storage of the first entries */
+	struct __lhttp_entry_s __small[LHTTP_LIST_INLINE_SIZE];
+
 } lhttp_list_t;
 
+/**
+ * @brief Name and value slices of one field, for `lhttp_list_add_all`
+ */
+typedef struct lhttp_list_field_s
+{
+	const char *name;  // field name, not necessarily NUL-terminated
+	size_t name_len;   // length of the field name
+	const char *value; // field value, not necessarily NUL-terminated
+	size_t value_len;  // length of the field value
+} lhttp_list_field_t;
+
+/**
+ * @brief Iterator over the values of one key of a HTTP list
+ */
+typedef struct lhttp_list_match_s
+{
+	/* Private fields. Used by method impls. */
+
+	lhttp_list_t *__list; // list being iterated
+	uint32_t __next;      // index of the next matching entry plus one
+} lhttp_list_match_t;
+
+/**
+ * @brief Iterator over every entry of a HTTP list, in insertion order
+ */
+typedef struct lhttp_list_iter_s
+{
+	/* Private fields. Used by method impls. */
+
+	lhttp_list_t *__list; // list being iterated
+	size_t __index;       // index of the next entry to visit
+} lhttp_list_iter_t;
+
 // clang-format off
 
 /**
@@ -156,6 +301,47 @@ typedef struct lhttp_list_s
  */
 lhttp_list_status_t lhttp_list_init(lhttp_list_t *list);
 
+/**
+ * @brief Initialize the HTTP list structure, allocating through `allocator`
+ * 
+ * @param list A pointer to the HTTP list structure
+ * @param allocator Allocator for the list memory, or NULL for `lhttp_allocator_libc`
+ * @return 0 on success. -1 on failure otherwise and the error code is set
+ * 
+ * @note Same as `lhttp_list_init`, except that entries and copied strings come
+ * from `allocator`. The allocator is not copied: it must outlive the list.
+ */
+lhttp_list_status_t lhttp_list_init_with_allocator(lhttp_list_t *list, const lhttp_allocator_t *allocator);
+
+/**
+ * @brief Set the flags of the HTTP list structure
+ * 
+ * @param list A pointer to the HTTP list structure
+ * @param flags A combination of `lhttp_list_flag_t` values
+ * @return 0 on success. -1 on failure otherwise and the error code is set
+ * 
+ * @note Flags can only be changed while the list is empty, since they decide
+ * how keys are hashed and stored. `LHTTP_LIST_ERROR_NOT_EMPTY` is set
+ * otherwise.
+ */
+lhttp_list_status_t lhttp_list_set_flags(lhttp_list_t *list, uint32_t flags);
+
+/**
+ * @brief Set the seed of the key hashes of the HTTP list structure
+ * 
+ * @param list A pointer to the HTTP list structure
+ * @param seed Any 64-bit value, ideally random
+ * @return 0 on success. -1 on failure otherwise and the error code is set
+ * 
+ * @note Keys are hashed with a seed so that clients cannot pick header names
+ * that collide in the index. By default, the seed is derived from a secret
+ * taken from the clock when the first list is initialized, and from the
+ * address of the list. Servers that want a stronger guarantee pass a value
+ * from their random source. Like flags, the seed can only be changed while
+ * the list is empty.
+ */
+lhttp_list_status_t lhttp_list_set_seed(lhttp_list_t *list, uint64_t seed);
+
 /**
  * @brief Add a key-value pair to the HTTP list structure
  * 
@@ -165,12 +351,71 @@ lhttp_list_status_t lhttp_list_init(lhttp_list_t *list);
  * @return 0 on success. -1 on failure otherwise and the error code is set
  * 
  * @note On adding, the key and the value will be copied to the list structure
- * via `strdup`. List structure is responsible for the copied values, not for 
+ * with the allocator of the list. List structure is responsible for the copied values, not for 
  * the original values. The caller is responsible for handling memory allocation
  * and deallocation of the original values.
+ * 
+ * A key that is already present is an error (`LHTTP_LIST_ERROR_KEY_EXISTS`),
+ * unless the list has the `LHTTP_LIST_MULTIMAP` flag: the value is then kept
+ * after the previous ones, as repeated fields such as `Set-Cookie` require.
  */
 lhttp_list_status_t lhttp_list_add(lhttp_list_t *list, const char *key, const char *value);
 
+/**
+ * @brief Add a key-value pair of `key_len` and `value_len` bytes to the HTTP
+ * list structure
+ * 
+ * @param list A pointer to the HTTP list structure
+ * @param key A key to be added to the list, not necessarily NUL-terminated
+ * @param key_len Length of `key`
+ * @param value A value to be added to the list, not necessarily NUL-terminated
+ * @param value_len Length of `value`
+ * @return 0 on success. -1 on failure otherwise and the error code is set
+ * 
+ * @note Same as `lhttp_list_add`, except that the lengths are given. The
+ * copies are NUL-terminated.
+ */
+lhttp_list_status_t lhttp_list_add_n(lhttp_list_t *list, const char *key, size_t key_len, const char *value, size_t value_len);
+
+/**
+ * @brief Add a key-value pair to the HTTP list structure without copying it
+ * 
+ * @param list A pointer to the HTTP list structure
+ * @param key A key to be added to the list, not necessarily NUL-terminated
+ * @param key_len Length of `key`
+ * @param value A value to be added to the list, not necessarily NUL-terminated
+ * @param value_len Length of `value`
+ * @return 0 on success. -1 on failure otherwise and the error code is set
+ * 
+ * @note The list only stores views of `key` and `value`: the caller keeps
+ * ownership of the bytes and must keep them alive and unchanged until the
+ * entry is removed or the list is freed. This is meant for headers indexed
+ * straight out of a request buffer. Borrowed values are not NUL-terminated
+ * unless the caller's bytes are, so they should be read with
+ * `lhttp_list_get_n`. Keys and values are limited to `UINT32_MAX` bytes.
+ */
+lhttp_list_status_t lhttp_list_add_borrowed(lhttp_list_t *list, const char *key, size_t key_len, const char *value, size_t value_len);
+
+/**
+ * @brief Add `count` key-value pairs to the HTTP list structure at once
+ * 
+ * @param list A pointer to the HTTP list structure
+ * @param fields Array of `count` name and value slices
+ * @param count Number of fields
+ * @return 0 on success. -1 on failure otherwise and the error code is set
+ * 
+ * @note Same as calling `lhttp_list_add_n` for every field, but the strings
+ * are all copied into a single allocation, and the storage and the index
+ * are sized once for the whole array. The block is only freed with the list,
+ * so the strings of removed fields are not reclaimed before.
+ * 
+ * The fields are added in order, and either all of them or none: if a name
+ * is already present (including earlier in `fields`) and the list does not
+ * have the `LHTTP_LIST_MULTIMAP` flag, nothing is added and the error is
+ * `LHTTP_LIST_ERROR_KEY_EXISTS`.
+ */
+lhttp_list_status_t lhttp_list_add_all(lhttp_list_t *list, const lhttp_list_field_t *fields, size_t count);
+
 /**
  * @brief Get the value with the `key` from `list` and store it in `value`
  * 
@@ -188,9 +433,83 @@ lhttp_list_status_t lhttp_list_add(lhttp_list_t *list, const char *key, const ch
  * If the `value` pointer is passed as `NULL`, the function will instead lookup
  * for `key` and return whether such key exists or not. No error is set upon
  * this operation, regardless of `key` exists or not.
+ * 
+ * In a `LHTTP_LIST_MULTIMAP` list, the first value of the key is stored. The
+ * others are visited with `lhttp_list_match_begin`.
  */
 lhttp_list_status_t lhttp_list_get(lhttp_list_t *list, const char *key, char **value);
 
+/**
+ * @brief Get the value with the `key` of `key_len` bytes from `list`
+ * 
+ * @param list A pointer to the HTTP list structure
+ * @param key A key to be searched in the list, not necessarily NUL-terminated
+ * @param key_len Length of `key`
+ * @param value A pointer to store the value, or NULL
+ * @param value_len A pointer to store the length of the value, or NULL
+ * @return 0 on success. -1 on failure otherwise and the error code is set.
+ * 
+ * @note Same as `lhttp_list_get`, for copied and borrowed entries alike.
+ */
+lhttp_list_status_t lhttp_list_get_n(lhttp_list_t *list, const char *key, size_t key_len, const char **value, size_t *value_len);
+
+/**
+ * @brief Start iterating over every value of `key` in `list`
+ * 
+ * @param list A pointer to the HTTP list structure
+ * @param key A key to be searched in the list, not necessarily NUL-terminated
+ * @param key_len Length of `key`
+ * @param match A pointer to the iterator to start
+ * @return 0 if the key has at least one value. -1 on failure otherwise and
+ * the error code is set.
+ * 
+ * @note Values are then visited in arrival order with `lhttp_list_match_next`.
+ * Only the entries of `key` are visited, so the cost is proportional to the
+ * number of matches. Without `LHTTP_LIST_MULTIMAP`, there is at most one.
+ * The iterator is invalidated by any change to the list.
+ */
+lhttp_list_status_t lhttp_list_match_begin(lhttp_list_t *list, const char *key, size_t key_len, lhttp_list_match_t *match);
+
+/**
+ * @brief Get the next value of an iteration started by
+ * `lhttp_list_match_begin`
+ * 
+ * @param match A pointer to the iterator
+ * @param value A pointer to store the value, or NULL
+ * @param value_len A pointer to store the length of the value, or NULL
+ * @return true if a value was stored, false once every value was visited
+ */
+bool lhttp_list_match_next(lhttp_list_match_t *match, const char **value, size_t *value_len);
+
+/**
+ * @brief Start iterating over every entry of `list`
+ * 
+ * @param list A pointer to the HTTP list structure
+ * @param iter A pointer to the iterator to start
+ * @return 0 on success. -1 on failure otherwise and the error code is set.
+ * 
+ * @note Entries are then visited with `lhttp_list_iter_next` in insertion
+ * order, which is also the order of the storage, so a whole header block can
+ * be forwarded in one linear pass. The iterator is invalidated by any change
+ * to the list.
+ */
+lhttp_list_status_t lhttp_list_iter_begin(lhttp_list_t *list, lhttp_list_iter_t *iter);
+
+/**
+ * @brief Get the next entry of an iteration started by `lhttp_list_iter_begin`
+ * 
+ * @param iter A pointer to the iterator
+ * @param key A pointer to store the key, or NULL
+ * @param key_len A pointer to store the length of the key, or NULL
+ * @param value A pointer to store the value, or NULL
+ * @param value_len A pointer to store the length of the value, or NULL
+ * @return true if an entry was stored, false once every entry was visited
+ * 
+ * @note Borrowed keys and values are not NUL-terminated, see
+ * `lhttp_list_add_borrowed`.
+ */
+bool lhttp_list_iter_next(lhttp_list_iter_t *iter, const char **key, size_t *key_len, const char **value, size_t *value_len);
+
 /**
  * @brief Remove the key-value pair with the `key` from `list`
  * 
@@ -199,18 +518,55 @@ lhttp_list_status_t lhttp_list_get(lhttp_list_t *list, const char *key, char **v
  * @return 0 on success. -1 on failure otherwise and the error code is set.
  * 
  * @note The `key` is used to search the key-value pair in the list. If the key
- * is found, the key-value pair will be removed from the list. If the caller is 
- * currently holding a pointer to the value, the value will be invalidated.
+ * is found, the key-value pair will be removed from the list. In a
+ * `LHTTP_LIST_MULTIMAP` list, every value of the key is removed. If the
+ * caller is currently holding a pointer to the value, the value will be
+ * invalidated.
  */
 lhttp_list_status_t lhttp_list_remove(lhttp_list_t *list, const char *key);
 
+/**
+ * @brief Remove the key-value pair with the `key` of `key_len` bytes from
+ * `list`
+ * 
+ * @param list A pointer to the HTTP list structure
+ * @param key A key to be searched in the list, not necessarily NUL-terminated
+ * @param key_len Length of `key`
+ * @return 0 on success. -1 on failure otherwise and the error code is set.
+ * 
+ * @note Same as `lhttp_list_remove`. A borrowed key and value are only
+ * forgotten, never freed.
+ */
+lhttp_list_status_t lhttp_list_remove_n(lhttp_list_t *list, const char *key, size_t key_len);
+
+/**
+ * @brief Make the HTTP list structure read-only, for faster lookups
+ * 
+ * @param list A pointer to the HTTP list structure
+ * @return 0 on success. -1 on failure otherwise and the error code is set.
+ * 
+ * @note Meant for lists that are built once and then only read, like the
+ * headers of a parsed request. Removed entries are compacted away and the
+ * hash index is replaced by an array of the key hashes sorted for binary
+ * search, which holds no empty slots. Large lists store that array in
+ * Eytzinger (breadth-first) order, so that the first steps of every search
+ * share the same few cache lines. Inline lists are already scanned and are
+ * left as they are.
+ * 
+ * Entries keep their insertion order, and lookups, iterators and matches
+ * work as before. Adding, removing and changing flags or the seed fail with
+ * `LHTTP_LIST_ERROR_FROZEN`. Freezing a frozen list does nothing, and
+ * `lhttp_list_free` frees a frozen list as usual.
+ */
+lhttp_list_status_t lhttp_list_freeze(lhttp_list_t *list);
+
 /**
  * @brief Free allocated memory of the HTTP list structure
  * 
  * @param list A pointer to the HTTP list structure
  * 
  * @note The caller is responsible for freeing the allocated memory, i.e. list 
- * nodes of the list structure. However, the caller is responsible for the 
+ * entries of the list structure. However, the caller is responsible for the 
  * pointer itself if the list structure is allocated via `malloc` or `calloc`.
  * 
  * All pointers that are returned by `lhttp_list_get` will be invalidated after
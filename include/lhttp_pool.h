@@ -0,0 +1,182 @@
+/* include/lhttp_pool.h
+ *
+ * Copyright (c) 2024 libhttp. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef LIBHTTP_POOL_H
+#define LIBHTTP_POOL_H 1
+
+#include <pthread.h>
+#include <stddef.h>
+
+#include <lhttp_allocator.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Alignment of every block handed out by the pool */
+#ifndef LHTTP_POOL_ALIGN
+#define LHTTP_POOL_ALIGN 16
+#endif
+
+/* Default number of blocks moved between a cache and its pool at once */
+#ifndef LHTTP_POOL_BATCH
+#define LHTTP_POOL_BATCH 64
+#endif
+
+/**
+ * @brief Private free block of a pool, linked into a batch of free blocks
+ */
+struct __lhttp_pool_block_s
+{
+	/* Next free block of the same batch */
+	struct __lhttp_pool_block_s *__next;
+
+	/* Next batch, only meaningful for the first block of a batch */
+	struct __lhttp_pool_block_s *__batch;
+};
+
+/**
+ * @brief Private header of a slab of pool memory, followed by its blocks
+ */
+struct __lhttp_pool_slab_s
+{
+	/* Next slab of the pool */
+	struct __lhttp_pool_slab_s *__next;
+};
+
+/**
+ * @brief Fixed-size block allocator shared by several threads
+ *
+ * @note The pool only hands out whole batches of free blocks, under a lock.
+ * Threads allocate and free through a `lhttp_pool_cache_t` of their own,
+ * which needs no locking, and go to the pool once per batch.
+ */
+typedef struct lhttp_pool_s
+{
+	/* Private fields. Used by method impls. */
+
+	const lhttp_allocator_t *__backing;   // allocator of the slabs
+	size_t __block_size;                  // size of every block
+	size_t __batch;                       // blocks per batch and per slab
+	pthread_mutex_t __lock;               // protects the fields below
+	struct __lhttp_pool_block_s *__full;  // stack of full batches
+	struct __lhttp_pool_block_s *__loose; // free blocks of partial batches
+	struct __lhttp_pool_slab_s *__slabs;  // every slab, for freeing
+} lhttp_pool_t;
+
+/**
+ * @brief Per-thread cache of free blocks of a `lhttp_pool_t`
+ *
+ * @note A cache must only be used by one thread at a time. Blocks may be
+ * given back through any cache of the same pool, not only the one that
+ * allocated them. Lists and requests keep the allocator of the cache they
+ * were initialized with, so they must be freed by the thread owning it.
+ */
+typedef struct lhttp_pool_cache_s
+{
+	/* Private fields. Used by method impls. */
+
+	lhttp_allocator_t __allocator;       // vtable allocating from the cache
+	lhttp_pool_t *__pool;                // pool the batches come from
+	struct __lhttp_pool_block_s *__free; // free blocks of this thread
+	size_t __count;                      // number of blocks in `__free`
+} lhttp_pool_cache_t;
+
+/**
+ * @brief Initialize a `lhttp_pool_t` structure
+ *
+ * @param pool A pointer to a `lhttp_pool_t` structure
+ * @param block_size Size of the blocks, rounded up to `LHTTP_POOL_ALIGN`
+ * @param batch Number of blocks per batch, or 0 for `LHTTP_POOL_BATCH`
+ * @param backing Allocator of the slabs, or NULL for `lhttp_allocator_libc`
+ * @return 0 on success, -1 on failure
+ *
+ * @note Nothing is allocated until the first block is requested. Slabs hold
+ * one batch of blocks each.
+ */
+int lhttp_pool_init(
+    lhttp_pool_t *pool,
+    size_t block_size,
+    size_t batch,
+    const lhttp_allocator_t *backing
+);
+
+/**
+ * @brief Free every slab of `pool`
+ *
+ * @param pool A pointer to an initialized `lhttp_pool_t` structure
+ *
+ * @note Every block is invalidated, and every cache of the pool must have
+ * been released with `lhttp_pool_cache_free` first.
+ */
+void lhttp_pool_free(lhttp_pool_t *pool);
+
+/**
+ * @brief Initialize a cache of `pool` for the calling thread
+ *
+ * @param cache A pointer to a `lhttp_pool_cache_t` structure
+ * @param pool A pointer to an initialized `lhttp_pool_t` structure
+ * @return 0 on success, -1 on failure
+ */
+int lhttp_pool_cache_init(lhttp_pool_cache_t *cache, lhttp_pool_t *pool);
+
+/**
+ * @brief Allocate one block from `cache`
+ *
+ * @param cache A pointer to an initialized `lhttp_pool_cache_t` structure
+ * @return A block of the pool's block size, aligned to `LHTTP_POOL_ALIGN`,
+ * or NULL on failure
+ */
+void *lhttp_pool_cache_alloc(lhttp_pool_cache_t *cache);
+
+/**
+ * @brief Give a block back to `cache`
+ *
+ * @param cache A pointer to an initialized `lhttp_pool_cache_t` structure
+ * @param block A block allocated from any cache of the same pool, or NULL
+ *
+ * @note Once the cache holds two batches, one of them goes back to the pool.
+ */
+void lhttp_pool_cache_release(lhttp_pool_cache_t *cache, void *block);
+
+/**
+ * @brief Get an allocator that allocates from `cache`
+ *
+ * @param cache A pointer to an initialized `lhttp_pool_cache_t` structure
+ * @return An allocator to pass to `lhttp_request_init_with_allocator` or
+ * `lhttp_list_init_with_allocator`, valid as long as the cache
+ *
+ * @note Requests up to the block size are served from the pool, larger ones
+ * from the backing allocator of the pool.
+ */
+const lhttp_allocator_t *lhttp_pool_cache_allocator(lhttp_pool_cache_t *cache);
+
+/**
+ * @brief Give every block of `cache` back to its pool
+ *
+ * @param cache A pointer to an initialized `lhttp_pool_cache_t` structure
+ *
+ * @note Meant to be called before the thread owning the cache exits. The
+ * cache can be used again afterwards.
+ */
+void lhttp_pool_cache_free(lhttp_pool_cache_t *cache);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LIBHTTP_POOL_H
@@ -27,6 +27,10 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <lhttp_allocator.h>
+#include <lhttp_list.h>
+#include <lhttp_uri.h>
+
 #ifdef DEBUG
 #include <stdio.h>
 #endif
@@ -85,22 +89,30 @@ typedef enum request_status_e
  * 
  * - `UNKNOWN`: Unknown error occurred. This is a generic error or an internal
  * error has occurred.
+ * 
+ * - `TOO_LARGE`: The message does not fit in the request buffer. This flag is
+ * combined with the flag of the part that was being parsed, e.g.
+ * `TOO_LARGE | URI` or `TOO_LARGE | HEADERS`.
  */
 typedef enum request_error_e
 {
-	LHTTP_REQUEST_ERROR_NONE              = 0b000000,
-	LHTTP_REQUEST_ERROR_METHOD            = 0b000001,
-	LHTTP_REQUEST_ERROR_URI               = 0b000010,
-	LHTTP_REQUEST_ERROR_VERSION           = 0b000100,
-	LHTTP_REQUEST_REQUEST_LINE            = 0b000111,
-	LHTTP_REQUEST_ERROR_HEADERS           = 0b001000,
-	LHTTP_REQUEST_ERROR_BODY              = 0b010000,
-	LHTTP_REQUEST_ERROR_MEMORY_ALLOCATION = 0b100000,
-	LHTTP_REQUEST_ERROR_UNKNOWN           = 0b111111,
+	LHTTP_REQUEST_ERROR_NONE              = 0b0000000,
+	LHTTP_REQUEST_ERROR_METHOD            = 0b0000001,
+	LHTTP_REQUEST_ERROR_URI               = 0b0000010,
+	LHTTP_REQUEST_ERROR_VERSION           = 0b0000100,
+	LHTTP_REQUEST_REQUEST_LINE            = 0b0000111,
+	LHTTP_REQUEST_ERROR_HEADERS           = 0b0001000,
+	LHTTP_REQUEST_ERROR_BODY              = 0b0010000,
+	LHTTP_REQUEST_ERROR_MEMORY_ALLOCATION = 0b0100000,
+	LHTTP_REQUEST_ERROR_UNKNOWN           = 0b0111111,
+	LHTTP_REQUEST_ERROR_TOO_LARGE         = 0b1000000,
 } lhttp_request_parsing_error_t;
 
 /**
  * @brief HTTP enum for HTTP methods stated by RFC 7231
+ * 
+ * Any other method that is a valid token is decoded as `EXTENSION`, and its
+ * name is left between the method markers of the request.
  */
 typedef enum
 {
@@ -113,9 +125,16 @@ typedef enum
 	LHTTP_METHOD_OPTIONS,
 	LHTTP_METHOD_TRACE,
 	LHTTP_METHOD_PATCH,
-	LHTTP_METHOD_INVALID
+	LHTTP_METHOD_INVALID,
+	LHTTP_METHOD_EXTENSION
 } lhttp_method_t;
 
+/**
+ * @brief HTTP enum for HTTP versions
+ * 
+ * A well-formed version other than 1.0 and 1.1 (e.g. "HTTP/2.0") is parsed
+ * as `INVALID`, which is not a parsing error by itself.
+ */
 typedef enum
 {
 	LHTTP_VERSION_1_0,
@@ -123,33 +142,206 @@ typedef enum
 	LHTTP_VERSION_INVALID
 } lhttp_version_t;
 
+/**
+ * @brief Forms of the request-target (RFC 9112 3.2)
+ * 
+ * The form is told apart from the method and the first bytes of the target:
+ * `CONNECT` takes the authority-form, a lone "*" is the asterisk-form, a '/'
+ * starts the origin-form, and a scheme followed by ':' the absolute-form. A
+ * target that fits none of them, like a CONNECT to a path, is `INVALID`,
+ * which is not a parsing error by itself.
+ */
+typedef enum
+{
+	LHTTP_URI_FORM_ORIGIN,
+	LHTTP_URI_FORM_ABSOLUTE,
+	LHTTP_URI_FORM_AUTHORITY,
+	LHTTP_URI_FORM_ASTERISK,
+	LHTTP_URI_FORM_INVALID
+} lhttp_uri_form_t;
+
+/**
+ * @brief Components of the request-target (RFC 3986 3)
+ * 
+ * The scheme and the authority are only found in the absolute-form, and the
+ * authority-form is nothing but an authority. Query and fragment exclude
+ * their '?' and '#' delimiters.
+ */
+typedef enum
+{
+	LHTTP_URI_SCHEME,
+	LHTTP_URI_AUTHORITY,
+	LHTTP_URI_PATH,
+	LHTTP_URI_QUERY,
+	LHTTP_URI_FRAGMENT,
+	LHTTP_URI_PART_COUNT
+} lhttp_uri_part_t;
+
+/**
+ * @brief IDs of the well-known header fields
+ * 
+ * Header names are matched to an ID while the header section is parsed, with
+ * a perfect hash generated by tools/gen_header_hash.py, so reading one of these
+ * fields later does not scan the header table. The order must match the list
+ * in the generator.
+ */
+typedef enum lhttp_header_id_e
+{
+	LHTTP_HEADER_ACCEPT,
+	LHTTP_HEADER_ACCEPT_CHARSET,
+	LHTTP_HEADER_ACCEPT_ENCODING,
+	LHTTP_HEADER_ACCEPT_LANGUAGE,
+	LHTTP_HEADER_AUTHORIZATION,
+	LHTTP_HEADER_CACHE_CONTROL,
+	LHTTP_HEADER_CONNECTION,
+	LHTTP_HEADER_CONTENT_ENCODING,
+	LHTTP_HEADER_CONTENT_LENGTH,
+	LHTTP_HEADER_CONTENT_TYPE,
+	LHTTP_HEADER_COOKIE,
+	LHTTP_HEADER_DATE,
+	LHTTP_HEADER_EXPECT,
+	LHTTP_HEADER_FORWARDED,
+	LHTTP_HEADER_HOST,
+	LHTTP_HEADER_IF_MATCH,
+	LHTTP_HEADER_IF_MODIFIED_SINCE,
+	LHTTP_HEADER_IF_NONE_MATCH,
+	LHTTP_HEADER_IF_RANGE,
+	LHTTP_HEADER_IF_UNMODIFIED_SINCE,
+	LHTTP_HEADER_KEEP_ALIVE,
+	LHTTP_HEADER_MAX_FORWARDS,
+	LHTTP_HEADER_ORIGIN,
+	LHTTP_HEADER_PRAGMA,
+	LHTTP_HEADER_PROXY_AUTHORIZATION,
+	LHTTP_HEADER_RANGE,
+	LHTTP_HEADER_REFERER,
+	LHTTP_HEADER_TE,
+	LHTTP_HEADER_TRAILER,
+	LHTTP_HEADER_TRANSFER_ENCODING,
+	LHTTP_HEADER_UPGRADE,
+	LHTTP_HEADER_USER_AGENT,
+	LHTTP_HEADER_VIA,
+	LHTTP_HEADER_X_FORWARDED_FOR,
+	LHTTP_HEADER_X_FORWARDED_HOST,
+	LHTTP_HEADER_X_FORWARDED_PROTO,
+	LHTTP_HEADER_X_REAL_IP,
+	LHTTP_HEADER_X_REQUEST_ID,
+	LHTTP_HEADER_UNKNOWN
+} lhttp_header_id_t;
+
+/**
+ * @brief Maximum number of header fields indexed per request. Requests with
+ * more header fields fail with `LHTTP_REQUEST_ERROR_TOO_LARGE`.
+ */
+#ifndef LHTTP_REQUEST_MAX_HEADERS
+#define LHTTP_REQUEST_MAX_HEADERS 64
+#endif
+
+/**
+ * @brief Longest request-target accepted by `lhttp_request_validate`. Longer
+ * ones are answered with 414 (URI Too Long).
+ */
+#ifndef LHTTP_REQUEST_MAX_URI_LENGTH
+#define LHTTP_REQUEST_MAX_URI_LENGTH 8000
+#endif
+
+/**
+ * @brief Longest field line (name and value) accepted by
+ * `lhttp_request_validate`. Longer ones are answered with 431 (Request Header
+ * Fields Too Large).
+ */
+#ifndef LHTTP_REQUEST_MAX_FIELD_LENGTH
+#define LHTTP_REQUEST_MAX_FIELD_LENGTH 8192
+#endif
+
+/**
+ * @brief Slice of a request-target component in the request message
+ * 
+ * The offset is counted from the first byte of the message, like the offsets
+ * of `lhttp_header_t`. The target always follows the method, so an offset of
+ * 0 marks a component the target does not have, which is not the same as an
+ * empty one (e.g. the query of "/a?").
+ */
+typedef struct lhttp_uri_slice_s
+{
+	uint32_t offset; // offset of the component, 0 when absent
+	uint32_t length; // length of the component
+} lhttp_uri_slice_t;
+
+/**
+ * @brief Slice of a header field in the request message
+ * 
+ * Offsets are counted from the first byte of the message, so the slices stay
+ * valid however the message was passed. The value excludes the surrounding
+ * optional whitespace (OWS).
+ */
+typedef struct lhttp_header_s
+{
+	uint32_t name_offset;  // offset of the field name
+	uint16_t name_length;  // length of the field name
+	uint16_t id;           // `lhttp_header_id_t` of the field name
+	uint32_t value_offset; // offset of the field value
+	uint32_t value_length; // length of the field value
+} lhttp_header_t;
+
 struct lhttp_request_s
 {
 	/* Public fields for HTTP request */
 
 	lhttp_method_t method;                 // HTTP method
 	lhttp_version_t version;               // HTTP version
-	char *uri;                             // URI
+	const char *uri;                       // URI, not NUL-terminated
+	size_t uri_len;                        // length of the URI
+	lhttp_uri_form_t uri_form;             // form of the URI
 	lhttp_request_parsing_status_t status; // Status of the request
 	lhttp_request_parsing_error_t error;   // Error when request status is ERROR
 
 	/* Private fields for parsing HTTP requests. Used by method impls. */
 
-	char *__buf;
-	size_t __buf_len;
-
-	char *__request_line_start; // start of the request line
-	char *__request_line_end;   // end of the request line
-	char *__method_start;       // start of the method string
-	char *__method_end;         // end of the method string
-	char *__uri_start;          // start of the URI string
-	char *__uri_end;            // end of the URI string
-	char *__version_start;      // start of the version string
-	char *__version_end;        // end of the version string
-	char *__headers_start;      // start of the header section
-	char *__headers_end;        // end of the header section
-	char *__body_start;         // start of the body
-	char *__body_end;           // end of the body
+	char *__buf;        // owned copy of the message, NULL when borrowed
+	size_t __buf_len;   // maximum size of the message
+	const char *__data; // message bytes, either `__buf` or the caller's buffer
+	size_t __data_len;  // amount of message bytes received so far
+	bool __borrowed;    // whether `__data` is borrowed from the caller
+
+	const lhttp_allocator_t *__allocator; // allocator of `__buf`
+
+	int __state;             // parser state to resume from, see lhttp_request.c
+	size_t __pos;            // offset of the first byte not accepted yet
+	size_t __body_remaining; // body bytes left in the message or chunk
+
+	const char *__request_line_start; // start of the request line
+	const char *__request_line_end;   // end of the request line
+	const char *__method_start;       // start of the method string
+	const char *__method_end;         // end of the method string
+	const char *__uri_start;          // start of the URI string
+	const char *__uri_end;            // end of the URI string
+	const char *__version_start;      // start of the version string
+	const char *__version_end;        // end of the version string
+	const char *__headers_start;      // start of the header section
+	const char *__headers_end;        // end of the header section
+	const char *__body_start;         // start of the body
+	const char *__body_end;           // end of the body
+
+	/* Components of the URI, split while the request line is swept. Indexed
+	by `lhttp_uri_part_t`. */
+	lhttp_uri_slice_t __uri_parts[LHTTP_URI_PART_COUNT];
+
+	/* Bit `1 << part` is set once the component was percent-decoded in place,
+	so that it is never decoded twice. */
+	uint8_t __uri_decoded;
+
+	/* Header fields in order of arrival, stored inline so that indexing the
+	header section never allocates. */
+	size_t __header_count;
+	lhttp_header_t __header_table[LHTTP_REQUEST_MAX_HEADERS];
+
+	/* 1 + offset of the first byte that no field value may hold (a CTL or
+	DEL), or 0. Found while indexing, reported by `lhttp_request_validate`. */
+	size_t __header_illegal;
+
+	/* Direct slot per well-known header: 1 + index of its first occurrence in
+	the header table, or 0 when the request does not have it. */
+	uint16_t __known_headers[LHTTP_HEADER_UNKNOWN];
 };
 
 /**
@@ -172,21 +364,259 @@ typedef struct lhttp_request_s lhttp_request_t;
  */
 int lhttp_request_init(lhttp_request_t *req, const size_t bufsz);
 
+/**
+ * @brief Initialize a `lhttp_request_t` structure with maximum buffer 
+ * size `bufsz`, allocating through `allocator`
+ * 
+ * @param req A pointer to a `lhttp_request_t` structure
+ * @param bufsz Maximum buffer size (amount of bytes)
+ * @param allocator Allocator for the request memory, or NULL for
+ * `lhttp_allocator_libc`
+ * @return int 0 on success, -1 on failure
+ * 
+ * @note Same as `lhttp_request_init`, except that the buffer comes from
+ * `allocator`. The allocator is not copied: it must outlive the request.
+ */
+int lhttp_request_init_with_allocator(
+    lhttp_request_t *req,
+    const size_t bufsz,
+    const lhttp_allocator_t *allocator
+);
+
+/**
+ * @brief Initialize a `lhttp_request_t` structure that parses the caller's
+ * buffer in place, for messages of at most `bufsz` bytes
+ * 
+ * @param req A pointer to a `lhttp_request_t` structure
+ * @param bufsz Maximum message size (amount of bytes)
+ * @return int 0 on success, -1 on failure
+ * 
+ * @note No memory is allocated, neither here nor when parsing. Instead of
+ * copying the message, `lhttp_request_parse` keeps pointers into the `data`
+ * passed by the caller, so the caller's buffer is borrowed:
+ * 
+ * - every chunk must start right where the previous chunk ended in memory,
+ * i.e. the caller keeps receiving into one contiguous buffer;
+ * 
+ * - the bytes passed so far must not be moved, modified or released until
+ * the request is freed or initialized again.
+ * 
+ * Breaking the first rule makes `lhttp_request_parse` return -1 without
+ * touching the request. Breaking the second one leaves the request pointing at
+ * stale data.
+ */
+int lhttp_request_init_borrowed(lhttp_request_t *req, const size_t bufsz);
+
+/**
+ * @brief Reset `lhttp_request_t` structure for the next message, keeping its
+ * buffer
+ * 
+ * @param req A pointer to an initialized `lhttp_request_t` structure
+ * @return 0 on success, -1 on failure
+ * 
+ * @note The request goes back to `LHTTP_REQUEST_PARSING_INITIALIZED` from any
+ * parsing status. Only the markers and the header index are cleared: nothing
+ * is allocated, freed or zeroed, which makes this the cheap way to reuse a
+ * request across keep-alive requests. A borrowed request forgets the
+ * caller's buffer and can start again anywhere. A request that was freed
+ * cannot be reset.
+ */
+int lhttp_request_reset(lhttp_request_t *req);
+
 /**
  * @brief Parse raw HTTP request `data` with length `len` into `lhttp_request_t *` structure
  * 
  * @param req A pointer to a `lhttp_request_t` structure
  * @param data Immutable raw HTTP request data
  * @param len Length of the raw HTTP request data
- * @return 0 on success, -1 on failure (e.g. invalid/bad request)
+ * @return 0 on success, `LHTTP_REQUEST_PARSING_ONGOING` if the message is not
+ * complete yet, -1 on failure (e.g. invalid/bad request)
  * 
  * @note The caller is responsible for checking the returned value. If an error
  * occurs, it means that the request is invalid and the caller should handle it.
+ * 
+ * The message may be passed in arbitrary fragments, e.g. as they come from the
+ * socket. Each call appends `data` to the request buffer and resumes parsing
+ * where the previous call stopped. Bytes accepted by an earlier call are not
+ * scanned again, so the total cost stays linear in the message size. When
+ * `LHTTP_REQUEST_PARSING_ONGOING` is returned, call again with the next chunk.
+ * 
+ * If the message cannot complete within the buffer size given to
+ * `lhttp_request_init`, parsing fails with `LHTTP_REQUEST_ERROR_TOO_LARGE`.
  */
 int lhttp_request_parse(lhttp_request_t *req, const char *data, size_t len);
 
 /**
- * @brief Validate HTTP request structure based on RFC 7230
+ * @brief Get the number of header fields in a parsed request
+ * 
+ * @param req A pointer to a `lhttp_request_t` structure
+ * @return Number of header fields, including repeated ones
+ */
+size_t lhttp_request_header_count(const lhttp_request_t *req);
+
+/**
+ * @brief Get the header field at `index`, in order of arrival
+ * 
+ * @param req A pointer to a `lhttp_request_t` structure
+ * @param index Index of the header field, below `lhttp_request_header_count`
+ * @param name A pointer to store the start of the field name
+ * @param name_len A pointer to store the length of the field name
+ * @param value A pointer to store the start of the field value
+ * @param value_len A pointer to store the length of the field value
+ * @return int 0 on success, -1 if `index` is out of range
+ * 
+ * @note The name and the value point into the message and are not
+ * NUL-terminated. They are valid as long as the message is.
+ */
+int lhttp_request_header_at(
+    const lhttp_request_t *req,
+    size_t index,
+    const char **name,
+    size_t *name_len,
+    const char **value,
+    size_t *value_len
+);
+
+/**
+ * @brief Get the value of a well-known header field in O(1)
+ * 
+ * @param req A pointer to a `lhttp_request_t` structure
+ * @param id ID of the header field
+ * @param value A pointer to store the start of the field value
+ * @param value_len A pointer to store the length of the field value
+ * @return int 0 on success, -1 if the request does not have the field
+ * 
+ * @note If the field is repeated, the first occurrence is returned. The other
+ * ones can be found with `lhttp_request_header_at`.
+ */
+int lhttp_request_header_get(
+    const lhttp_request_t *req,
+    lhttp_header_id_t id,
+    const char **value,
+    size_t *value_len
+);
+
+/**
+ * @brief Get a component of the URI of a parsed request in O(1)
+ * 
+ * @param req A pointer to a `lhttp_request_t` structure
+ * @param part The component to get
+ * @param value A pointer to store the start of the component
+ * @param value_len A pointer to store the length of the component
+ * @return int 0 on success, -1 if the URI does not have the component
+ * 
+ * @note The components are split while the request line is parsed, with the
+ * same forward sweep that finds the end of the URI, so getting one never
+ * scans the URI again. Like header fields, they point into the message, are
+ * not NUL-terminated and are not percent-decoded. A component that is present
+ * but empty, like the query of "/a?", is returned with a length of 0.
+ */
+int lhttp_request_uri_part(
+    const lhttp_request_t *req,
+    lhttp_uri_part_t part,
+    const char **value,
+    size_t *value_len
+);
+
+/**
+ * @brief Percent-decode a component of the URI of a parsed request in place
+ * 
+ * @param req A pointer to a `lhttp_request_t` structure
+ * @param part The component to decode
+ * @param mode `LHTTP_URI_DECODE_FORM` to also decode '+' to a space, e.g. for
+ * the query, `LHTTP_URI_DECODE_PATH` otherwise
+ * @return int 0 on success, -1 if the request is not parsed, is borrowed or
+ * does not have the component, if the path is to be decoded in another mode
+ * than `LHTTP_URI_DECODE_PATH`, or if the component has a bad escape, which
+ * includes an encoded slash in `LHTTP_URI_DECODE_PATH` mode
+ * 
+ * @note The component is decoded with `lhttp_uri_decode` in the request
+ * buffer, and `lhttp_request_uri_part` returns the decoded bytes from then
+ * on. Decoding a component again does nothing. A borrowed request cannot be
+ * decoded, since its message belongs to the caller.
+ * 
+ * The bytes freed by decoding are left between the component and the next
+ * one, so `uri` no longer spells the request-target: validate the request
+ * before decoding it.
+ */
+int lhttp_request_uri_decode(
+    lhttp_request_t *req,
+    lhttp_uri_part_t part,
+    lhttp_uri_decode_mode_t mode
+);
+
+/**
+ * @brief Normalize the path of a parsed request in place
+ * 
+ * @param req A pointer to a `lhttp_request_t` structure
+ * @return int 0 on success, -1 if the request is not parsed, is borrowed,
+ * has no absolute path or has a decoded path, or if the path climbs above
+ * the root
+ * 
+ * @note The path is normalized with `lhttp_uri_normalize_path` in the request
+ * buffer, and `lhttp_request_uri_part` returns the normalized path from then
+ * on. Normalize the path before decoding it: decoding refuses encoded
+ * slashes, so the decoded path has the segments that were normalized, and a
+ * path that was already decoded is refused, since its "%2e" may stand for a
+ * decoded "%252e". A borrowed request cannot be normalized.
+ */
+int lhttp_request_uri_normalize(lhttp_request_t *req);
+
+/**
+ * @brief Copy every header field of a parsed request into `list`
+ * 
+ * @param req A pointer to a `lhttp_request_t` structure
+ * @param list A pointer to an initialized `lhttp_list_t` structure
+ * @return int 0 on success, -1 on failure and the error code of `list` is set
+ * 
+ * @note The fields are added in order of arrival with `lhttp_list_add_all`,
+ * so the names and values are copied into a single block and stay valid
+ * after the request is reset. Field names are case-insensitive and may be
+ * repeated, so `list` should have the `LHTTP_LIST_CASE_INSENSITIVE` and
+ * `LHTTP_LIST_MULTIMAP` flags; otherwise a repeated field fails with
+ * `LHTTP_LIST_ERROR_KEY_EXISTS` and nothing is added.
+ */
+int lhttp_request_header_list(const lhttp_request_t *req, lhttp_list_t *list);
+
+/**
+ * @brief Map a header field name to its ID, ignoring case
+ * 
+ * @param name Header field name, not necessarily NUL-terminated
+ * @param len Length of the name
+ * @return The ID of the name, or `LHTTP_HEADER_UNKNOWN`
+ */
+lhttp_header_id_t lhttp_header_id(const char *name, size_t len);
+
+/**
+ * @brief Parse at most one HTTP message out of a stream of bytes
+ * 
+ * @param req A pointer to a `lhttp_request_t` structure
+ * @param data Immutable raw HTTP request data
+ * @param len Length of the raw HTTP request data
+ * @param consumed A pointer to store the number of bytes of `data` that belong
+ * to the message, or NULL
+ * @return 0 on success, `LHTTP_REQUEST_PARSING_ONGOING` if the message is not
+ * complete yet, -1 on failure (e.g. invalid/bad request)
+ * 
+ * @note This is `lhttp_request_parse` for connections that pipeline several
+ * requests. The message ends after its body, as framed by Content-Length or
+ * by the chunked transfer coding, and the bytes that follow are left to the
+ * caller. On success, `*consumed` is the number of bytes taken from this
+ * chunk, and the next message starts at `data + *consumed`. With a borrowed
+ * request, the caller can parse it in place after initializing the request
+ * again. When more data is needed, the whole chunk is consumed.
+ * 
+ * A chunked body is not decoded: the body markers span the chunked encoding.
+ */
+int lhttp_request_parse_stream(
+    lhttp_request_t *req,
+    const char *data,
+    size_t len,
+    size_t *consumed
+);
+
+/**
+ * @brief Validate HTTP request structure based on RFC 9110 and RFC 9112
  * 
  * @param req A pointer to a `lhttp_request_t` structure
  * @param http_status HTTP status code
@@ -196,6 +626,34 @@ int lhttp_request_parse(lhttp_request_t *req, const char *data, size_t len);
  * occurs, it means there is an internal error happening. If the returned value
  * is 0, it could mean that the request is valid or invalid. The caller should
  * check the `http_status` value afterwards.
+ * 
+ * A parsed request is checked in one pass over the request line and the
+ * field names, every byte against a table of character classes. Field values
+ * are not scanned again: their illegal bytes were found while the header
+ * section was indexed, with vector compares where the CPU has them.
+ * 
+ * - 400 (Bad Request): the method or a field name is not a token, the
+ * request-target has a byte outside of RFC 3986 or a bad percent-encoding, its
+ * form does not match the method (only CONNECT takes the authority-form and
+ * only OPTIONS the asterisk-form), a field value has a control character, or
+ * Host is missing from an HTTP/1.1 request or repeated;
+ * 
+ * - 414 (URI Too Long): the request-target is longer than
+ * `LHTTP_REQUEST_MAX_URI_LENGTH`;
+ * 
+ * - 431 (Request Header Fields Too Large): a field line is longer than
+ * `LHTTP_REQUEST_MAX_FIELD_LENGTH`;
+ * 
+ * - 505 (HTTP Version Not Supported): the version is well-formed but neither
+ * HTTP/1.0 nor HTTP/1.1;
+ * 
+ * - 200 (OK) otherwise.
+ * 
+ * The first failure in message order is reported. A request that failed to
+ * parse is not scanned again: its error is mapped to 400, or to 414, 431 or
+ * 413 (Content Too Large) when the URI, the header section or the body did
+ * not fit in the buffer. -1 is only returned for a request that is neither
+ * parsed nor failed, and for memory and internal errors.
  */
 int lhttp_request_validate(lhttp_request_t *req, int *http_status);
 
@@ -205,9 +663,9 @@ int lhttp_request_validate(lhttp_request_t *req, int *http_status);
  * @param req A pointer to a `lhttp_request_t` structure
  * 
  * @note The caller is only responsible for deallocating the allocated memory
- * in the request struct members. If the request struct is an allocated pointer,
- * for example via `malloc` or `calloc`, the caller should be responsible for 
- * freeing the pointer itself.
+ * in the request struct members. A borrowed buffer is never freed. If the
+ * request struct is an allocated pointer, for example via `malloc` or
+ * `calloc`, the caller should be responsible for freeing the pointer itself.
  */
 void lhttp_request_free(lhttp_request_t *req);
 
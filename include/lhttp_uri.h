@@ -0,0 +1,102 @@
+/* include/lhttp_uri.h
+ *
+ * Copyright (c) 2024 libhttp. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef LIBHTTP_URI_H
+#define LIBHTTP_URI_H 1
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief How `lhttp_uri_decode` treats the bytes that are not escapes
+ *
+ * - `PATH`: only "%XX" escapes are decoded (RFC 3986 2.1), a '+' stays a '+'.
+ * An encoded slash or backslash ("%2F", "%5C") is an error.
+ *
+ * - `FORM`: a '+' is also decoded to a space, as in query strings of the
+ * application/x-www-form-urlencoded type
+ */
+typedef enum
+{
+	LHTTP_URI_DECODE_PATH,
+	LHTTP_URI_DECODE_FORM
+} lhttp_uri_decode_mode_t;
+
+/**
+ * @brief Percent-decode the `len` bytes at `data` in place
+ *
+ * @param data Bytes to decode, overwritten with the decoded bytes
+ * @param len Number of bytes to decode
+ * @param mode Whether a '+' is decoded to a space
+ * @param decoded_len A pointer to store the number of decoded bytes
+ * @return int 0 on success, -1 on a '%' not followed by two hexadecimal
+ * digits, on an encoded NUL ("%00"), or on an encoded slash or backslash in
+ * `LHTTP_URI_DECODE_PATH` mode
+ *
+ * @note Every escape shrinks 3 bytes to 1, so the decoded bytes never outrun
+ * the bytes still to decode and no buffer is needed. Runs of bytes with
+ * nothing to decode are skipped with the vector scanner of the request
+ * parser, 16 or 32 bytes per compare, and moved down in one `memmove`. Data
+ * without any escape is not written to at all.
+ *
+ * On failure, the bytes before the bad escape may already be decoded: the
+ * data should be dropped along with the request. The result is not
+ * NUL-terminated, and it may hold any other byte. A path must not gain
+ * separators once decoded, or "/a/..%2F..%2Fetc" would climb out of "/a"
+ * after having been normalized, hence the encoded slashes it refuses.
+ */
+int lhttp_uri_decode(
+    char *data,
+    size_t len,
+    lhttp_uri_decode_mode_t mode,
+    size_t *decoded_len
+);
+
+/**
+ * @brief Remove the dot-segments of the absolute path `path` and merge its
+ * repeated slashes, in place
+ *
+ * @param path Path to normalize, starting with '/', overwritten with the
+ * normalized path
+ * @param len Length of the path, 0 for an empty path
+ * @param normalized_len A pointer to store the length of the normalized path
+ * @return int 0 on success, -1 if the path does not start with '/' or if a
+ * ".." segment climbs above the root
+ *
+ * @note This is "remove_dot_segments" of RFC 3986 5.2.4, in one pass from
+ * left to right: "." segments are dropped, ".." drops the segment before it,
+ * and a path ending in either keeps its trailing slash ("/a/.." is "/").
+ * Empty segments are merged too, so "//a" is "/a". Unlike the RFC, ".." at
+ * the root is an error rather than ignored, since it is how a request tries
+ * to escape the document root. Dots may be percent-encoded ("%2e"), as the
+ * path is expected to be encoded still: it must be decoded afterwards, never
+ * before, or a double-encoded "%252e%252e" would pass as a plain segment and
+ * become ".." if decoded once more.
+ *
+ * An already normalized path, the common case, is only read: the output
+ * only starts to be written once a segment was removed.
+ */
+int lhttp_uri_normalize_path(char *path, size_t len, size_t *normalized_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LIBHTTP_URI_H
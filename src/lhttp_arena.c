@@ -0,0 +1,218 @@
+/* Copyright (c) 2024 libhttp. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <lhttp_arena.h>
+
+#include <stdint.h>
+#include <string.h>
+
+#include "lhttp_memory.h"
+
+/* Chunk headers are padded so that the data after them stays aligned */
+#define LHTTP_ARENA_ROUND(size)                                               \
+	(((size) + (LHTTP_ARENA_ALIGN - 1)) & ~(size_t)(LHTTP_ARENA_ALIGN - 1))
+
+#define LHTTP_ARENA_HEADER                                                    \
+	LHTTP_ARENA_ROUND(sizeof(struct __lhttp_arena_chunk_s))
+
+static inline char *__lhttp_arena_data(struct __lhttp_arena_chunk_s *chunk)
+{
+	return (char *)chunk + LHTTP_ARENA_HEADER;
+}
+
+static void *__lhttp_arena_malloc(void *ctx, size_t size)
+{
+	return lhttp_arena_alloc(ctx, size);
+}
+
+static void *
+__lhttp_arena_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size)
+{
+	lhttp_arena_t *arena = ctx;
+	char *block          = ptr;
+	void *copy;
+
+	// The last block grows or shrinks in place when its chunk has room
+	if (block != NULL &&
+	    block + LHTTP_ARENA_ROUND(old_size) == arena->__ptr &&
+	    (size_t)(arena->__end - block) >= new_size)
+	{
+		arena->__ptr = block + LHTTP_ARENA_ROUND(new_size);
+		return block;
+	}
+
+	copy = lhttp_arena_alloc(arena, new_size);
+	if (copy != NULL && block != NULL)
+	{
+		memcpy(copy, block, old_size < new_size ? old_size : new_size);
+	}
+
+	return copy;
+}
+
+static void __lhttp_arena_release(void *ctx, void *ptr, size_t size)
+{
+	lhttp_arena_t *arena = ctx;
+	char *block          = ptr;
+
+	// Only the last block can be given back, the others wait for a reset
+	if (block + LHTTP_ARENA_ROUND(size) == arena->__ptr)
+	{
+		arena->__ptr = block;
+	}
+}
+
+int lhttp_arena_init(
+    lhttp_arena_t *arena,
+    size_t chunk_size,
+    const lhttp_allocator_t *backing
+)
+{
+	if (arena == NULL)
+	{
+		return -1;
+	}
+
+	arena->__allocator.malloc_fn  = __lhttp_arena_malloc;
+	arena->__allocator.realloc_fn = __lhttp_arena_realloc;
+	arena->__allocator.free_fn    = __lhttp_arena_release;
+	arena->__allocator.ctx        = arena;
+
+	arena->__backing    = __lhttp_allocator(backing);
+	arena->__chunk_size = LHTTP_ARENA_ROUND(
+	    chunk_size > 0 ? chunk_size : LHTTP_ARENA_CHUNK_SIZE
+	);
+	arena->__first = NULL;
+	arena->__chunk = NULL;
+	arena->__ptr   = NULL;
+	arena->__end   = NULL;
+
+	return 0;
+}
+
+/**
+ * @brief Move to a chunk with at least `size` free bytes, reusing the chunks
+ * kept by a reset when they are large enough
+ * 
+ * @return 0 on success, -1 on failure
+ */
+static int __lhttp_arena_grow(lhttp_arena_t *arena, size_t size)
+{
+	struct __lhttp_arena_chunk_s *chunk;
+	size_t data_size;
+
+	chunk = arena->__chunk != NULL ? arena->__chunk->__next : arena->__first;
+	if (chunk == NULL || chunk->__size < size)
+	{
+		data_size = size > arena->__chunk_size ? size : arena->__chunk_size;
+		if (data_size > SIZE_MAX - LHTTP_ARENA_HEADER)
+		{
+			return -1;
+		}
+
+		chunk = __lhttp_malloc(
+		    arena->__backing,
+		    LHTTP_ARENA_HEADER + data_size
+		);
+		if (chunk == NULL)
+		{
+			return -1;
+		}
+
+		chunk->__size = data_size;
+
+		// Link the new chunk right after the current one, so that a chunk
+		// too small for this block is still reused after the next reset
+		if (arena->__chunk != NULL)
+		{
+			chunk->__next          = arena->__chunk->__next;
+			arena->__chunk->__next = chunk;
+		}
+		else
+		{
+			chunk->__next  = arena->__first;
+			arena->__first = chunk;
+		}
+	}
+
+	arena->__chunk = chunk;
+	arena->__ptr   = __lhttp_arena_data(chunk);
+	arena->__end   = arena->__ptr + chunk->__size;
+
+	return 0;
+}
+
+void *lhttp_arena_alloc(lhttp_arena_t *arena, size_t size)
+{
+	char *block;
+
+	if (size > SIZE_MAX - LHTTP_ARENA_ALIGN)
+	{
+		return NULL;
+	}
+
+	size = LHTTP_ARENA_ROUND(size);
+
+	if ((size_t)(arena->__end - arena->__ptr) < size || arena->__ptr == NULL)
+	{
+		if (__lhttp_arena_grow(arena, size) != 0)
+		{
+			return NULL;
+		}
+	}
+
+	block        = arena->__ptr;
+	arena->__ptr = block + size;
+
+	return block;
+}
+
+const lhttp_allocator_t *lhttp_arena_allocator(lhttp_arena_t *arena)
+{
+	return &arena->__allocator;
+}
+
+void lhttp_arena_reset(lhttp_arena_t *arena)
+{
+	arena->__chunk = arena->__first;
+
+	if (arena->__first != NULL)
+	{
+		arena->__ptr = __lhttp_arena_data(arena->__first);
+		arena->__end = arena->__ptr + arena->__first->__size;
+	}
+}
+
+void lhttp_arena_free(lhttp_arena_t *arena)
+{
+	struct __lhttp_arena_chunk_s *chunk = arena->__first;
+	struct __lhttp_arena_chunk_s *next  = NULL;
+
+	while (chunk != NULL)
+	{
+		next = chunk->__next;
+		__lhttp_free(
+		    arena->__backing,
+		    chunk,
+		    LHTTP_ARENA_HEADER + chunk->__size
+		);
+		chunk = next;
+	}
+
+	arena->__first = NULL;
+	arena->__chunk = NULL;
+	arena->__ptr   = NULL;
+	arena->__end   = NULL;
+}
@@ -0,0 +1,111 @@
+/* src/lhttp_ascii.h
+ *
+ * Copyright (c) 2024 libhttp. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/* Private ASCII case folding helpers. Only A-Z are folded: field names are
+ * tokens, and tokens are ASCII. This header is not part of the public API and
+ * is not installed. */
+
+#ifndef LIBHTTP_ASCII_H
+#define LIBHTTP_ASCII_H 1
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/* SSE2 is part of x86-64, so it needs neither a target attribute nor a
+ * runtime check */
+#if !defined(LHTTP_NO_SIMD) && defined(__SSE2__)
+#define LHTTP_ASCII_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Fold the ASCII upper case letter `c` to lower case
+ */
+static inline unsigned char __lhttp_ascii_fold(unsigned char c)
+{
+	return c + ((unsigned char)(c - 'A') < 26 ? 0x20 : 0);
+}
+
+#ifdef LHTTP_ASCII_SSE2
+/**
+ * @brief Fold the ASCII upper case letters of a 16-byte block to lower case
+ */
+static inline __m128i __lhttp_ascii_fold16(__m128i block)
+{
+	// Bytes from 0x80 are negative as signed bytes, so they are never taken
+	// for letters
+	const __m128i upper = _mm_and_si128(
+	    _mm_cmpgt_epi8(block, _mm_set1_epi8('A' - 1)),
+	    _mm_cmpgt_epi8(_mm_set1_epi8('Z' + 1), block)
+	);
+
+	return _mm_or_si128(block, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+}
+#endif
+
+/**
+ * @brief Compare `len` bytes of `a` and `b` ignoring ASCII case
+ * 
+ * @return true if both ranges are equal once folded
+ */
+static inline bool
+__lhttp_ascii_caseeq(const char *a, const char *b, size_t len)
+{
+	size_t i;
+
+#ifdef LHTTP_ASCII_SSE2
+	// Long names such as Access-Control-Allow-Credentials are folded 16
+	// bytes at a time, the last block overlapping the previous one
+	if (len > 16)
+	{
+		for (i = 0;; i += 16)
+		{
+			__m128i x, y;
+
+			if (i + 16 > len)
+				i = len - 16;
+
+			x = __lhttp_ascii_fold16(_mm_loadu_si128((const __m128i *)(a + i)));
+			y = __lhttp_ascii_fold16(_mm_loadu_si128((const __m128i *)(b + i)));
+
+			if (_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) != 0xFFFF)
+				return false;
+
+			if (i + 16 == len)
+				return true;
+		}
+	}
+#endif
+
+	for (i = 0; i < len; i++)
+	{
+		if (__lhttp_ascii_fold(a[i]) != __lhttp_ascii_fold(b[i]))
+			return false;
+	}
+
+	return true;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LIBHTTP_ASCII_H
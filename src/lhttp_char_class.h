@@ -0,0 +1,99 @@
+/* src/lhttp_char_class.h
+ *
+ * Generated by tools/gen_char_class.py. Do not edit by hand.
+ */
+
+#ifndef LIBHTTP_CHAR_CLASS_H
+#define LIBHTTP_CHAR_CLASS_H 1
+
+/* Token characters of method and field names (RFC 9110 5.6.2) */
+#define LHTTP_CHAR_TCHAR 0x01
+
+/* Bytes of a field value: VCHAR, obs-text, SP and HTAB (RFC 9110 5.5) */
+#define LHTTP_CHAR_FIELD 0x02
+
+/* Literal request-target bytes: unreserved and reserved (RFC 3986) */
+#define LHTTP_CHAR_URI 0x04
+
+/* Hexadecimal digits */
+#define LHTTP_CHAR_HEX 0x08
+
+/* ASCII letters, which start a URI scheme */
+#define LHTTP_CHAR_ALPHA 0x10
+
+/* Bytes of a URI scheme (RFC 3986 3.1) */
+#define LHTTP_CHAR_SCHEME 0x20
+
+/* Classes of every byte, a combination of the bits above */
+static const unsigned char __lhttp_char_class[256] = {
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x00
+	0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x08
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x10
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x18
+	0x02, 0x07, 0x02, 0x07, 0x07, 0x03, 0x07, 0x07, // 0x20
+	0x06, 0x06, 0x07, 0x27, 0x06, 0x27, 0x27, 0x06, // 0x28
+	0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, 0x2f, // 0x30
+	0x2f, 0x2f, 0x06, 0x06, 0x02, 0x06, 0x02, 0x06, // 0x38
+	0x06, 0x3f, 0x3f, 0x3f, 0x3f, 0x3f, 0x3f, 0x37, // 0x40
+	0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, // 0x48
+	0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, // 0x50
+	0x37, 0x37, 0x37, 0x06, 0x02, 0x06, 0x03, 0x07, // 0x58
+	0x03, 0x3f, 0x3f, 0x3f, 0x3f, 0x3f, 0x3f, 0x37, // 0x60
+	0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, // 0x68
+	0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, 0x37, // 0x70
+	0x37, 0x37, 0x37, 0x02, 0x03, 0x02, 0x07, 0x00, // 0x78
+	0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, // 0x80
+	0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, // 0x88
+	0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, // 0x90
+	0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, // 0x98
+	0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, // 0xa0
+	0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, // 0xa8
+	0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, // 0xb0
+	0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, // 0xb8
+	0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, // 0xc0
+	0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, // 0xc8
+	0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, // 0xd0
+	0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, // 0xd8
+	0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, // 0xe0
+	0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, // 0xe8
+	0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, // 0xf0
+	0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, // 0xf8
+};
+
+/* Value of every hexadecimal digit, 0xff for other bytes */
+static const unsigned char __lhttp_hex_digit[256] = {
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, // 0x00
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, // 0x08
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, // 0x10
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, // 0x18
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, // 0x20
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, // 0x28
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, // 0x30
+	0x08, 0x09, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, // 0x38
+	0xff, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0xff, // 0x40
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, // 0x48
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, // 0x50
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, // 0x58
+	0xff, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0xff, // 0x60
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, // 0x68
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, // 0x70
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, // 0x78
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, // 0x80
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, // 0x88
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, // 0x90
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, // 0x98
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, // 0xa0
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, // 0xa8
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, // 0xb0
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, // 0xb8
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, // 0xc0
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, // 0xc8
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, // 0xd0
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, // 0xd8
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, // 0xe0
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, // 0xe8
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, // 0xf0
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, // 0xf8
+};
+
+#endif // LIBHTTP_CHAR_CLASS_H
@@ -0,0 +1,149 @@
+/* src/lhttp_hash.h
+ *
+ * Copyright (c) 2024 libhttp. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/* Private seeded string hash, in the style of wyhash: keys are read 8 or 16
+ * bytes at a time and mixed with 64x64->128 bit multiplications. This header
+ * is not part of the public API and is not installed. */
+
+#ifndef LIBHTTP_HASH_H
+#define LIBHTTP_HASH_H 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Odd constants with balanced bits, from wyhash */
+#define LHTTP_HASH_P0 0xa0761d6478bd642fULL
+#define LHTTP_HASH_P1 0xe7037ed1a0b428dbULL
+
+/* Sets the 0x20 bit of every byte, folding ASCII letters to lower case */
+#define LHTTP_HASH_FOLD 0x2020202020202020ULL
+
+/**
+ * @brief Multiply `a` and `b` to 128 bits and fold the halves together
+ */
+static inline uint64_t __lhttp_hash_mix(uint64_t a, uint64_t b)
+{
+#ifdef __SIZEOF_INT128__
+	__uint128_t r = (__uint128_t)a * b;
+
+	return (uint64_t)r ^ (uint64_t)(r >> 64);
+#else
+	// Four 32x32 products, for targets without 128-bit integers
+	uint64_t ha = a >> 32, la = (uint32_t)a, hb = b >> 32, lb = (uint32_t)b;
+	uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+	uint64_t t  = rl + (rm0 << 32);
+	uint64_t lo = t + (rm1 << 32);
+	uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + (t < rl) + (lo < t);
+
+	return lo ^ hi;
+#endif
+}
+
+static inline uint64_t __lhttp_hash_read8(const char *p)
+{
+	uint64_t v;
+
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+static inline uint64_t __lhttp_hash_read4(const char *p)
+{
+	uint32_t v;
+
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+/**
+ * @brief Hash the `len` bytes of `key` with `seed`
+ *
+ * @param fold `LHTTP_HASH_FOLD` to hash keys ignoring ASCII case, 0 otherwise
+ * @return A 32-bit hash
+ *
+ * @note Folding sets the 0x20 bit of every byte, one OR per word. Besides
+ * letters, that also merges a few pairs of other bytes, which only costs a
+ * comparison.
+ */
+static inline uint32_t
+__lhttp_hash(uint64_t seed, const char *key, size_t len, uint64_t fold)
+{
+	const char *p = key;
+	uint64_t a, b, h;
+	size_t i;
+
+	seed ^= LHTTP_HASH_P0;
+
+	if (len <= 16)
+	{
+		if (len >= 4)
+		{
+			// Two overlapping pairs of 4-byte reads cover 4 to 16 bytes
+			a = __lhttp_hash_read4(p) << 32 |
+			    __lhttp_hash_read4(p + ((len >> 3) << 2));
+			b = __lhttp_hash_read4(p + len - 4) << 32 |
+			    __lhttp_hash_read4(p + len - 4 - ((len >> 3) << 2));
+		}
+		else if (len > 0)
+		{
+			a = (uint64_t)(unsigned char)p[0] << 16 |
+			    (uint64_t)(unsigned char)p[len >> 1] << 8 |
+			    (unsigned char)p[len - 1];
+			b = 0;
+		}
+		else
+		{
+			a = 0;
+			b = 0;
+		}
+
+		a |= fold;
+		b |= fold;
+	}
+	else
+	{
+		for (i = len; i > 16; i -= 16, p += 16)
+		{
+			seed = __lhttp_hash_mix(
+			    (__lhttp_hash_read8(p) | fold) ^ LHTTP_HASH_P1,
+			    (__lhttp_hash_read8(p + 8) | fold) ^ seed
+			);
+		}
+
+		// The last 16 bytes, overlapping the previous block
+		a = __lhttp_hash_read8(key + len - 16) | fold;
+		b = __lhttp_hash_read8(key + len - 8) | fold;
+	}
+
+	h = __lhttp_hash_mix(
+	    LHTTP_HASH_P1 ^ len,
+	    __lhttp_hash_mix(a ^ LHTTP_HASH_P1, b ^ seed)
+	);
+
+	return (uint32_t)(h ^ h >> 32);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LIBHTTP_HASH_H
@@ -0,0 +1,133 @@
+/* src/lhttp_header_hash.h
+ *
+ * Generated by tools/gen_header_hash.py. Do not edit by hand.
+ */
+
+#ifndef LIBHTTP_HEADER_HASH_H
+#define LIBHTTP_HEADER_HASH_H 1
+
+#define LHTTP_HEADER_HASH_A 1
+#define LHTTP_HEADER_HASH_B 3
+#define LHTTP_HEADER_HASH_C 25
+#define LHTTP_HEADER_HASH_SIZE 128
+
+/* Lowercase name of every well-known header, indexed by ID */
+static const char *const __lhttp_header_names[] = {
+	"accept",
+	"accept-charset",
+	"accept-encoding",
+	"accept-language",
+	"authorization",
+	"cache-control",
+	"connection",
+	"content-encoding",
+	"content-length",
+	"content-type",
+	"cookie",
+	"date",
+	"expect",
+	"forwarded",
+	"host",
+	"if-match",
+	"if-modified-since",
+	"if-none-match",
+	"if-range",
+	"if-unmodified-since",
+	"keep-alive",
+	"max-forwards",
+	"origin",
+	"pragma",
+	"proxy-authorization",
+	"range",
+	"referer",
+	"te",
+	"trailer",
+	"transfer-encoding",
+	"upgrade",
+	"user-agent",
+	"via",
+	"x-forwarded-for",
+	"x-forwarded-host",
+	"x-forwarded-proto",
+	"x-real-ip",
+	"x-request-id",
+};
+
+/* Length of every well-known header name, indexed by ID */
+static const unsigned char __lhttp_header_lengths[] = {
+	6, 14, 15, 15, 13, 13, 10, 16,
+	14, 12, 6, 4, 6, 9, 4, 8,
+	17, 13, 8, 19, 10, 12, 6, 6,
+	19, 5, 7, 2, 7, 17, 7, 10,
+	3, 15, 16, 17, 9, 12,
+};
+
+/* Hash slot to header ID, or LHTTP_HEADER_UNKNOWN */
+static const unsigned char __lhttp_header_slots[] = {
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_TE, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_COOKIE,
+	LHTTP_HEADER_X_FORWARDED_HOST, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_MAX_FORWARDS, LHTTP_HEADER_IF_UNMODIFIED_SINCE,
+	LHTTP_HEADER_X_FORWARDED_PROTO, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_ACCEPT_LANGUAGE,
+	LHTTP_HEADER_IF_MODIFIED_SINCE, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_X_REAL_IP, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_HOST,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_TRANSFER_ENCODING,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_RANGE, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_CONTENT_LENGTH, LHTTP_HEADER_DATE,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_PRAGMA, LHTTP_HEADER_CACHE_CONTROL,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_CONTENT_TYPE, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_VIA,
+	LHTTP_HEADER_ACCEPT_ENCODING, LHTTP_HEADER_UPGRADE,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_CONTENT_ENCODING,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_IF_MATCH, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_REFERER, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_IF_NONE_MATCH,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_CONNECTION, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_FORWARDED, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_TRAILER, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_AUTHORIZATION,
+	LHTTP_HEADER_ORIGIN, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_ACCEPT, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_ACCEPT_CHARSET, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_EXPECT, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_IF_RANGE,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_KEEP_ALIVE,
+	LHTTP_HEADER_USER_AGENT, LHTTP_HEADER_X_REQUEST_ID,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_PROXY_AUTHORIZATION,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_UNKNOWN,
+	LHTTP_HEADER_UNKNOWN, LHTTP_HEADER_X_FORWARDED_FOR,
+};
+
+#endif // LIBHTTP_HEADER_HASH_H
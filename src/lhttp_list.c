@@ -15,6 +15,12 @@
 
 #include <lhttp_list.h>
 
+#include <time.h>
+
+#include "lhttp_ascii.h"
+#include "lhttp_hash.h"
+#include "lhttp_memory.h"
+
 #define MEMCHECK_ALLOC_STRING(value)                      \
 	if (value == NULL)                                    \
 	{                                                     \
@@ -22,110 +28,1132 @@
 		return LHTTP_LIST_ERROR;                          \
 	}
 
-#define LHTTP_LIST_FOREACH(list, key, code_block)          \
-	struct __lhttp_node_s *current = list->__head->__next; \
-	for (; current != NULL; current = current->__next)     \
-	{                                                      \
-		if (strcmp(current->__key, key) == 0)              \
-		{                                                  \
-			code_block                                     \
-		}                                                  \
+/* Smallest number of slots of the index */
+#define LHTTP_LIST_MIN_SLOTS 8
+
+/* Entries are chained by a 31-bit field, one value is kept for the end */
+#define LHTTP_LIST_MAX_ENTRIES (UINT32_MAX >> 1)
+
+/* Position returned by lookups that find nothing */
+#define LHTTP_LIST_NPOS SIZE_MAX
+
+/* Frozen lists with more keys than this are searched in Eytzinger order */
+#define LHTTP_LIST_EYTZINGER_MIN 32
+
+/* Entries ahead of the iterator whose strings are prefetched */
+#define LHTTP_LIST_PREFETCH_DISTANCE 4
+
+#if defined(__GNUC__)
+#define LHTTP_LIST_PREFETCH(addr) __builtin_prefetch((addr), 0, 3)
+#else
+#define LHTTP_LIST_PREFETCH(addr) ((void)(addr))
+#endif
+
+/* Process-wide secret the default seeds are derived from, 0 until the first
+ * list is initialized. Threads racing to set it each store a valid secret,
+ * and a list only ever uses the seed it was initialized with. */
+static uint64_t __lhttp_list_secret;
+
+/**
+ * @brief Seeded hash of the `len` bytes of `key`
+ * 
+ * @note In a case-insensitive list, every byte is hashed with its 0x20 bit
+ * set. That folds ASCII letters inline, and the few other bytes it merges
+ * only cost a comparison.
+ */
+static inline uint32_t
+__lhttp_list_hash(const lhttp_list_t *list, const char *key, size_t len)
+{
+	return __lhttp_hash(
+	    list->__seed,
+	    key,
+	    len,
+	    list->__flags & LHTTP_LIST_CASE_INSENSITIVE ? LHTTP_HASH_FOLD : 0
+	);
+}
+
+/**
+ * @brief Derive the default seed of `list` from the process secret and the
+ * address of the list
+ */
+static uint64_t __lhttp_list_default_seed(const lhttp_list_t *list)
+{
+	uint64_t secret = __atomic_load_n(&__lhttp_list_secret, __ATOMIC_RELAXED);
+	struct timespec ts;
+
+	if (secret == 0)
+	{
+		// The clock and the address space layout are not known to clients
+		clock_gettime(CLOCK_REALTIME, &ts);
+		secret = __lhttp_hash_mix(
+		    (uint64_t)ts.tv_sec ^ LHTTP_HASH_P0,
+		    (uint64_t)ts.tv_nsec ^ (uintptr_t)&__lhttp_list_secret
+		) | 1;
+
+		__atomic_store_n(&__lhttp_list_secret, secret, __ATOMIC_RELAXED);
+	}
+
+	return __lhttp_hash_mix(secret, (uintptr_t)list ^ LHTTP_HASH_P1);
+}
+
+/**
+ * @brief Check whether `entry` has the key `key` of length `len`
+ */
+static inline bool __lhttp_list_match(
+    const lhttp_list_t *list,
+    const struct __lhttp_entry_s *entry,
+    const char *key,
+    size_t len
+)
+{
+	if (entry->__key_len != len)
+	{
+		return false;
+	}
+
+	if (list->__flags & LHTTP_LIST_CASE_INSENSITIVE)
+	{
+		return __lhttp_ascii_caseeq(entry->__key, key, len);
+	}
+
+	return memcmp(entry->__key, key, len) == 0;
+}
+
+/**
+ * @brief Distance of the slot at `pos` from the home slot of its hash
+ */
+static inline size_t
+__lhttp_list_distance(const lhttp_list_t *list, size_t pos, uint32_t hash)
+{
+	return (pos - (hash & list->__mask)) & list->__mask;
+}
+
+/**
+ * @brief Get the entry storage of `list`, inline until it spills to the heap
+ */
+static inline struct __lhttp_entry_s *__lhttp_list_entries(lhttp_list_t *list)
+{
+	return list->__entries != NULL ? list->__entries : list->__small;
+}
+
+/**
+ * @brief Check whether `list` can be read, frozen or not
+ */
+static inline bool __lhttp_list_readable(const lhttp_list_t *list)
+{
+	return list->state == LHTTP_LIST_INITIALIZED ||
+	       list->state == LHTTP_LIST_FROZEN;
+}
+
+/**
+ * @brief Error of a change attempted on `list` while it is not writable
+ */
+static inline lhttp_list_error_t
+__lhttp_list_state_error(const lhttp_list_t *list)
+{
+	return list->state == LHTTP_LIST_FROZEN ? LHTTP_LIST_ERROR_FROZEN
+	                                        : LHTTP_LIST_ERROR_NOT_INITIALIZED;
+}
+
+/**
+ * @brief Copy `key` and `value` into `entry`, both NUL-terminated in a single
+ * allocation
+ * 
+ * @return 0 on success, -1 on failure
+ */
+static inline int __lhttp_list_copy(
+    lhttp_list_t *list,
+    struct __lhttp_entry_s *entry,
+    const char *key,
+    size_t key_len,
+    const char *value,
+    size_t value_len
+)
+{
+	char *copy;
+
+	copy = __lhttp_malloc(list->__allocator, key_len + value_len + 2);
+	if (copy == NULL)
+	{
+		return -1;
+	}
+
+	memcpy(copy, key, key_len);
+	copy[key_len] = '\0';
+	memcpy(copy + key_len + 1, value, value_len);
+	copy[key_len + 1 + value_len] = '\0';
+
+	entry->__key   = copy;
+	entry->__value = copy + key_len + 1;
+	entry->__owned = 1;
+
+	return 0;
+}
+
+/**
+ * @brief Free the strings of `entry` and mark it as removed
+ */
+static inline void
+__lhttp_list_release(lhttp_list_t *list, struct __lhttp_entry_s *entry)
+{
+	if (entry->__key == NULL)
+	{
+		return;
+	}
+
+	// The value is stored right after the key
+	if (entry->__owned)
+	{
+		__lhttp_free(
+		    list->__allocator,
+		    (char *)entry->__key,
+		    entry->__key_len + entry->__value_len + 2
+		);
+	}
+
+	entry->__key   = NULL;
+	entry->__value = NULL;
+}
+
+/**
+ * @brief Position after `k` in an Eytzinger array of `n` keys, 0 past the
+ * last one
+ */
+static inline size_t __lhttp_list_eytzinger_next(size_t k, size_t n)
+{
+	// The leftmost node of the right subtree, if there is one
+	if (2 * k + 1 <= n)
+	{
+		for (k = 2 * k + 1; 2 * k <= n; k *= 2)
+			;
+
+		return k;
+	}
+
+	// Otherwise the first ancestor whose left subtree holds `k`
+	while (k & 1)
+	{
+		k >>= 1;
+	}
+
+	return k >> 1;
+}
+
+/**
+ * @brief Find the entry of `key` in the sorted keys of a frozen list
+ * 
+ * @return The index of the entry, or `LHTTP_LIST_NPOS` if the key is not in
+ * the list
+ */
+static size_t __lhttp_list_frozen_find(
+    const lhttp_list_t *list,
+    const char *key,
+    size_t key_len,
+    uint32_t hash
+)
+{
+	const struct __lhttp_slot_s *keys = list->__slots;
+	struct __lhttp_entry_s *entries   = list->__entries;
+	const size_t n                    = list->__mask;
+	size_t k, len;
+
+	if (n > LHTTP_LIST_EYTZINGER_MIN)
+	{
+		// Descend to the first key not below `hash`, then drop the right
+		// turns taken after it
+		for (k = 1; k <= n; k = 2 * k + (keys[k].__hash < hash))
+		{
+			// The descendants three levels down share one cache line
+			LHTTP_LIST_PREFETCH(keys + 8 * k);
+		}
+
+		k >>= __builtin_ffsll(~(unsigned long long)k);
+
+		for (; k != 0 && keys[k].__hash == hash;
+		     k = __lhttp_list_eytzinger_next(k, n))
+		{
+			if (__lhttp_list_match(
+			        list,
+			        &entries[keys[k].__index - 1],
+			        key,
+			        key_len
+			    ))
+			{
+				return keys[k].__index - 1;
+			}
+		}
+
+		return LHTTP_LIST_NPOS;
+	}
+
+	// Branchless lower bound: the base only moves by a conditional add
+	for (k = 1, len = n; len > 1; len -= len / 2)
+	{
+		k += keys[k + len / 2].__hash < hash ? len / 2 : 0;
+	}
+
+	k += n > 0 && keys[k].__hash < hash;
+
+	for (; k <= n && keys[k].__hash == hash; k++)
+	{
+		if (__lhttp_list_match(
+		        list,
+		        &entries[keys[k].__index - 1],
+		        key,
+		        key_len
+		    ))
+		{
+			return keys[k].__index - 1;
+		}
+	}
+
+	return LHTTP_LIST_NPOS;
+}
+
+/**
+ * @brief Find the entry of `key`
+ * 
+ * @param list An existing HTTP list
+ * @param key A key to be searched in the list
+ * @param key_len Length of `key`
+ * @param hash Hash of `key`, only used once the list is indexed
+ * @param slot_pos A pointer to store the position of the slot of the entry,
+ * only set once the list is indexed
+ * @return The index of the entry, or `LHTTP_LIST_NPOS` if the key is not in
+ * the list
+ */
+static inline size_t __lhttp_list_find(
+    lhttp_list_t *list,
+    const char *key,
+    size_t key_len,
+    uint32_t hash,
+    size_t *slot_pos
+)
+{
+	struct __lhttp_entry_s *entries = __lhttp_list_entries(list);
+	size_t pos, dist, i;
+
+	if (list->state == LHTTP_LIST_FROZEN && list->__slots != NULL)
+	{
+		return __lhttp_list_frozen_find(list, key, key_len, hash);
+	}
+
+	if (list->__slots == NULL)
+	{
+		// Small lists are scanned: their hashes are kept apart in a single
+		// cache line, so only the entries with the same hash are read
+		for (i = 0; i < list->__count; i++)
+		{
+			if (list->__small_hashes[i] == hash && entries[i].__key != NULL &&
+			    __lhttp_list_match(list, &entries[i], key, key_len))
+			{
+				return i;
+			}
+		}
+
+		return LHTTP_LIST_NPOS;
+	}
+
+	pos = hash & list->__mask;
+	for (dist = 0;; dist++, pos = (pos + 1) & list->__mask)
+	{
+		const struct __lhttp_slot_s *slot = &list->__slots[pos];
+
+		// Robin Hood order: the key would have been placed before any slot
+		// that is closer to its own home
+		if (slot->__index == 0 ||
+		    __lhttp_list_distance(list, pos, slot->__hash) < dist)
+		{
+			return LHTTP_LIST_NPOS;
+		}
+
+		if (slot->__hash == hash &&
+		    __lhttp_list_match(list, &entries[slot->__index - 1], key, key_len))
+		{
+			*slot_pos = pos;
+			return slot->__index - 1;
+		}
+	}
+}
+
+/**
+ * @brief Place the entry at `index` with hash `hash` in the index, which
+ * must have a free slot
+ */
+static inline void
+__lhttp_list_place(lhttp_list_t *list, uint32_t hash, uint32_t index)
+{
+	struct __lhttp_slot_s carry = {
+	    .__hash  = hash,
+	    .__index = index + 1,
+	    .__tail  = index + 1,
+	};
+	size_t pos                  = hash & list->__mask;
+	size_t dist                 = 0;
+
+	for (;; dist++, pos = (pos + 1) & list->__mask)
+	{
+		struct __lhttp_slot_s *slot = &list->__slots[pos];
+		size_t slot_dist;
+
+		if (slot->__index == 0)
+		{
+			*slot = carry;
+			return;
+		}
+
+		// Take the slot from an entry closer to its home and carry that
+		// entry further instead
+		slot_dist = __lhttp_list_distance(list, pos, slot->__hash);
+		if (slot_dist < dist)
+		{
+			struct __lhttp_slot_s swap = *slot;
+
+			*slot = carry;
+			carry = swap;
+			dist  = slot_dist;
+		}
+	}
+}
+
+/**
+ * @brief Empty the slot at `pos` of the index
+ */
+static inline void __lhttp_list_unplace(lhttp_list_t *list, size_t pos)
+{
+	size_t next = (pos + 1) & list->__mask;
+
+	// Backward shift deletion: pull the following displaced slots one step
+	// closer to their home, so that no tombstone is needed in the index
+	while (list->__slots[next].__index != 0 &&
+	       __lhttp_list_distance(list, next, list->__slots[next].__hash) > 0)
+	{
+		list->__slots[pos] = list->__slots[next];
+		pos                = next;
+		next               = (next + 1) & list->__mask;
+	}
+
+	list->__slots[pos].__index = 0;
+}
+
+/**
+ * @brief Chain the entry at `index` after the last entry of the key whose
+ * first entry is at `head`, and whose slot is at `pos` once indexed
+ */
+static inline void __lhttp_list_chain(
+    lhttp_list_t *list,
+    size_t head,
+    size_t pos,
+    size_t index
+)
+{
+	struct __lhttp_entry_s *entries = __lhttp_list_entries(list);
+	struct __lhttp_slot_s *slot;
+
+	// Inline chains are short enough to be walked
+	if (list->__slots == NULL)
+	{
+		while (entries[head].__next != 0)
+		{
+			head = entries[head].__next - 1;
+		}
+
+		entries[head].__next = index + 1;
+		return;
+	}
+
+	// The slot of the key knows its last entry, so appends stay constant
+	// however often the key repeats
+	slot                             = &list->__slots[pos];
+	entries[slot->__tail - 1].__next = index + 1;
+	slot->__tail                     = index + 1;
+}
+
+/**
+ * @brief Rebuild the chains of repeated keys of inline entries, after their
+ * indices changed
+ */
+static void __lhttp_list_relink(lhttp_list_t *list)
+{
+	struct __lhttp_entry_s *entries = __lhttp_list_entries(list);
+	size_t i, j;
+
+	for (i = 0; i < list->__count; i++)
+	{
+		entries[i].__next = 0;
+	}
+
+	// Inline storage is small enough for a quadratic pass
+	for (i = 0; i < list->__count; i++)
+	{
+		for (j = i + 1; j < list->__count; j++)
+		{
+			if (entries[j].__hash == entries[i].__hash &&
+			    __lhttp_list_match(
+			        list,
+			        &entries[j],
+			        entries[i].__key,
+			        entries[i].__key_len
+			    ))
+			{
+				entries[i].__next = j + 1;
+				break;
+			}
+		}
+	}
+}
+
+/**
+ * @brief Rebuild the index with `slots` slots from the live entries
+ * 
+ * @return 0 on success, -1 on failure
+ */
+static int __lhttp_list_rehash(lhttp_list_t *list, size_t slots)
+{
+	struct __lhttp_slot_s *table;
+	size_t i;
+
+	table = __lhttp_malloc(list->__allocator, slots * sizeof(*table));
+	if (table == NULL)
+	{
+		return -1;
+	}
+
+	memset(table, 0, slots * sizeof(*table));
+
+	if (list->__slots != NULL)
+	{
+		__lhttp_free(
+		    list->__allocator,
+		    list->__slots,
+		    (list->__mask + 1) * sizeof(*table)
+		);
+	}
+
+	list->__slots = table;
+	list->__mask  = slots - 1;
+
+	for (i = 0; i < list->__count; i++)
+	{
+		struct __lhttp_entry_s *entry = &list->__entries[i];
+		size_t head, pos;
+
+		// Keys are not hashed again, their hash was kept in the entry
+		if (entry->__key == NULL)
+		{
+			continue;
+		}
+
+		// Only the first entry of a key is indexed, the others are chained
+		// to it in order
+		if (list->__flags & LHTTP_LIST_MULTIMAP)
+		{
+			entry->__next = 0;
+			head          = __lhttp_list_find(
+			    list,
+			    entry->__key,
+			    entry->__key_len,
+			    entry->__hash,
+			    &pos
+			);
+
+			if (head != LHTTP_LIST_NPOS)
+			{
+				__lhttp_list_chain(list, head, pos, i);
+				continue;
+			}
+		}
+
+		__lhttp_list_place(list, entry->__hash, i);
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Move the live entries to the front of the storage, keeping their
+ * order
+ */
+static void __lhttp_list_compact(lhttp_list_t *list)
+{
+	struct __lhttp_entry_s *entries = __lhttp_list_entries(list);
+	size_t i, live = 0;
+
+	for (i = 0; i < list->__count; i++)
+	{
+		if (entries[i].__key != NULL)
+		{
+			if (list->__entries == NULL)
+			{
+				list->__small_hashes[live] = list->__small_hashes[i];
+			}
+
+			entries[live++] = entries[i];
+		}
+	}
+
+	list->__count = live;
+
+	if (list->__entries == NULL && list->__flags & LHTTP_LIST_MULTIMAP)
+	{
+		__lhttp_list_relink(list);
+	}
+}
+
+/**
+ * @brief Grow the entry storage to at least `needed` entries, moving it to
+ * the heap when it is inline
+ * 
+ * @return 0 on success, -1 on failure
+ */
+static int __lhttp_list_grow(lhttp_list_t *list, size_t needed)
+{
+	size_t capacity = list->__capacity * 2;
+	struct __lhttp_entry_s *entries;
+
+	while (capacity < needed && capacity <= LHTTP_LIST_MAX_ENTRIES)
+	{
+		capacity *= 2;
+	}
+
+	if (capacity > LHTTP_LIST_MAX_ENTRIES)
+	{
+		capacity = LHTTP_LIST_MAX_ENTRIES;
+	}
+
+	if (capacity <= list->__capacity || capacity < needed)
+	{
+		return -1;
+	}
+
+	if (list->__entries == NULL)
+	{
+		entries = __lhttp_malloc(
+		    list->__allocator,
+		    capacity * sizeof(*entries)
+		);
+		if (entries == NULL)
+		{
+			return -1;
+		}
+
+		memcpy(entries, list->__small, sizeof(list->__small));
+	}
+	else
+	{
+		entries = __lhttp_realloc(
+		    list->__allocator,
+		    list->__entries,
+		    list->__capacity * sizeof(*entries),
+		    capacity * sizeof(*entries)
+		);
+		if (entries == NULL)
+		{
+			return -1;
+		}
+	}
+
+	list->__entries  = entries;
+	list->__capacity = capacity;
+
+	return 0;
+}
+
+/**
+ * @brief Make room for `n` more entries in the storage and in the index
+ * 
+ * @return 0 on success, -1 on failure
+ */
+static int __lhttp_list_reserve(lhttp_list_t *list, size_t n)
+{
+	size_t slots = list->__slots != NULL ? list->__mask + 1 : 0;
+	bool rehash  = false;
+
+	if (n > LHTTP_LIST_MAX_ENTRIES - list->__count)
+	{
+		return -1;
+	}
+
+	if (list->__count + n > list->__capacity)
+	{
+		size_t holes = list->__count - list->__size;
+
+		// Inline storage is compacted as long as it has a hole, rather than
+		// spilled to the heap
+		if (holes > 0 &&
+		    (list->__entries == NULL || holes >= list->__count / 2))
+		{
+			// Mostly removed entries: reclaim them instead of growing, the
+			// indices change so the index is rebuilt as well
+			__lhttp_list_compact(list);
+			rehash = slots > 0;
+		}
+
+		if (list->__count + n > list->__capacity &&
+		    __lhttp_list_grow(list, list->__count + n) != 0)
+		{
+			return -1;
+		}
+	}
+
+	// Inline entries are scanned, only the heap storage is indexed
+	if (list->__entries == NULL)
+	{
+		return 0;
+	}
+
+	// Keep the load factor of the index at most 3/4
+	if (slots == 0)
+	{
+		slots = LHTTP_LIST_MIN_SLOTS;
+	}
+
+	while ((list->__size + n) * 4 > slots * 3)
+	{
+		slots *= 2;
+	}
+
+	if (rehash || slots != list->__mask + 1 || list->__slots == NULL)
+	{
+		return __lhttp_list_rehash(list, slots);
+	}
+
+	return 0;
+}
+
+lhttp_list_status_t lhttp_list_init(lhttp_list_t *list)
+{
+	return lhttp_list_init_with_allocator(list, NULL);
+}
+
+lhttp_list_status_t
+lhttp_list_init_with_allocator(lhttp_list_t *list, const lhttp_allocator_t *a)
+{
+	list->state       = LHTTP_LIST_UNSET;
+	list->error       = LHTTP_LIST_ERROR_NONE;
+	list->__allocator = __lhttp_allocator(a);
+
+	// Entries are stored inline until there are too many of them
+	list->__entries  = NULL;
+	list->__count    = 0;
+	list->__capacity = LHTTP_LIST_INLINE_SIZE;
+	list->__slots    = NULL;
+	list->__mask     = 0;
+	list->__size     = 0;
+	list->__flags    = 0;
+	list->__blocks   = NULL;
+	list->__seed     = __lhttp_list_default_seed(list);
+
+	list->state = LHTTP_LIST_INITIALIZED;
+
+	return LHTTP_LIST_OK;
+}
+
+/**
+ * @brief Add an entry, copied or borrowed
+ * 
+ * @param copy Whether the list copies the strings or borrows them
+ */
+static lhttp_list_status_t __lhttp_list_insert(
+    lhttp_list_t *list,
+    const char *key,
+    size_t key_len,
+    const char *value,
+    size_t value_len,
+    bool copy
+)
+{
+	struct __lhttp_entry_s *entry;
+	uint32_t hash;
+	size_t pos, head;
+
+	if (list->state != LHTTP_LIST_INITIALIZED)
+	{
+		list->error = __lhttp_list_state_error(list);
+		return LHTTP_LIST_ERROR;
+	}
+
+	if (key == NULL || value == NULL)
+	{
+		list->error = key == NULL ? LHTTP_LIST_ERROR_KEY_NULL
+		                          : LHTTP_LIST_ERROR_VALUE_NULL;
+		return LHTTP_LIST_ERROR;
+	}
+
+	// Lengths are stored in 32 bits
+	if (key_len > UINT32_MAX || value_len > UINT32_MAX)
+	{
+		list->error = LHTTP_LIST_UNKNOWN_ERROR;
+		return LHTTP_LIST_ERROR;
+	}
+
+	hash = __lhttp_list_hash(list, key, key_len);
+	head = __lhttp_list_find(list, key, key_len, hash, &pos);
+
+	if (head != LHTTP_LIST_NPOS && !(list->__flags & LHTTP_LIST_MULTIMAP))
+	{
+		list->error = LHTTP_LIST_ERROR_KEY_EXISTS;
+		return LHTTP_LIST_ERROR;
+	}
+
+	if (__lhttp_list_reserve(list, 1) != 0)
+	{
+		list->error = LHTTP_LIST_ERROR_MEMORY_ALLOCATION;
+		return LHTTP_LIST_ERROR;
+	}
+
+	// Making room may have moved the entries, and turned on the index
+	if (head != LHTTP_LIST_NPOS)
+	{
+		head = __lhttp_list_find(list, key, key_len, hash, &pos);
+	}
+
+	entry = &__lhttp_list_entries(list)[list->__count];
+
+	if (copy)
+	{
+		if (__lhttp_list_copy(list, entry, key, key_len, value, value_len))
+		{
+			list->error = LHTTP_LIST_ERROR_MEMORY_ALLOCATION;
+			return LHTTP_LIST_ERROR;
+		}
+	}
+	else
+	{
+		entry->__key   = key;
+		entry->__value = value;
+		entry->__owned = 0;
+	}
+
+	entry->__key_len   = key_len;
+	entry->__value_len = value_len;
+	entry->__hash      = hash;
+	entry->__next      = 0;
+
+	if (list->__entries == NULL)
+	{
+		list->__small_hashes[list->__count] = hash;
+	}
+
+	// Append the entry to the list, indexing it once the list is large. A
+	// repeated key is chained after its previous entries instead.
+	if (head != LHTTP_LIST_NPOS)
+	{
+		__lhttp_list_chain(list, head, pos, list->__count);
+	}
+	else if (list->__slots != NULL)
+	{
+		__lhttp_list_place(list, hash, list->__count);
+	}
+
+	list->__count++;
+	list->__size++;
+
+	list->error = LHTTP_LIST_ERROR_NONE;
+	return LHTTP_LIST_OK;
+}
+
+lhttp_list_status_t lhttp_list_set_flags(lhttp_list_t *list, uint32_t flags)
+{
+	if (list->state != LHTTP_LIST_INITIALIZED)
+	{
+		list->error = __lhttp_list_state_error(list);
+		return LHTTP_LIST_ERROR;
+	}
+
+	// Entries already placed were hashed and compared with the former flags
+	if (list->__count > 0)
+	{
+		list->error = LHTTP_LIST_ERROR_NOT_EMPTY;
+		return LHTTP_LIST_ERROR;
+	}
+
+	list->__flags = flags;
+
+	list->error = LHTTP_LIST_ERROR_NONE;
+	return LHTTP_LIST_OK;
+}
+
+lhttp_list_status_t lhttp_list_set_seed(lhttp_list_t *list, uint64_t seed)
+{
+	if (list->state != LHTTP_LIST_INITIALIZED)
+	{
+		list->error = __lhttp_list_state_error(list);
+		return LHTTP_LIST_ERROR;
+	}
+
+	// Entries already placed were hashed with the former seed
+	if (list->__count > 0)
+	{
+		list->error = LHTTP_LIST_ERROR_NOT_EMPTY;
+		return LHTTP_LIST_ERROR;
+	}
+
+	list->__seed = seed;
+
+	list->error = LHTTP_LIST_ERROR_NONE;
+	return LHTTP_LIST_OK;
+}
+
+lhttp_list_status_t
+lhttp_list_add(lhttp_list_t *list, const char *key, const char *value)
+{
+	return __lhttp_list_insert(
+	    list,
+	    key,
+	    key != NULL ? strlen(key) : 0,
+	    value,
+	    value != NULL ? strlen(value) : 0,
+	    true
+	);
+}
+
+lhttp_list_status_t lhttp_list_add_n(
+    lhttp_list_t *list,
+    const char *key,
+    size_t key_len,
+    const char *value,
+    size_t value_len
+)
+{
+	return __lhttp_list_insert(list, key, key_len, value, value_len, true);
+}
+
+lhttp_list_status_t lhttp_list_add_borrowed(
+    lhttp_list_t *list,
+    const char *key,
+    size_t key_len,
+    const char *value,
+    size_t value_len
+)
+{
+	return __lhttp_list_insert(list, key, key_len, value, value_len, false);
+}
+
+/**
+ * @brief Take back the entries appended by `lhttp_list_add_all` from
+ * `count` on, after a duplicate key was found
+ */
+static void __lhttp_list_unwind(lhttp_list_t *list, size_t count)
+{
+	struct __lhttp_entry_s *entries = __lhttp_list_entries(list);
+	struct __lhttp_entry_s *entry;
+	size_t pos = 0;
+
+	while (list->__count > count)
+	{
+		entry = &entries[--list->__count];
+		list->__size--;
+
+		// Keys are unique without `LHTTP_LIST_MULTIMAP`, so the entry is
+		// the one found
+		if (list->__slots != NULL)
+		{
+			__lhttp_list_find(
+			    list,
+			    entry->__key,
+			    entry->__key_len,
+			    entry->__hash,
+			    &pos
+			);
+			__lhttp_list_unplace(list, pos);
+		}
 	}
+}
 
-static inline struct __lhttp_node_s *__lhttp_node_create()
+lhttp_list_status_t lhttp_list_add_all(
+    lhttp_list_t *list,
+    const lhttp_list_field_t *fields,
+    size_t count
+)
 {
-	struct __lhttp_node_s *node = calloc(1, sizeof(struct __lhttp_node_s));
-	if (node == NULL)
+	struct __lhttp_list_block_s *block;
+	struct __lhttp_entry_s *entry;
+	size_t i, pos, head, start, total = 0;
+	uint32_t hash;
+	char *data;
+
+	if (list->state != LHTTP_LIST_INITIALIZED)
 	{
-		return NULL;
+		list->error = __lhttp_list_state_error(list);
+		return LHTTP_LIST_ERROR;
 	}
 
-	node->__key   = NULL;
-	node->__value = NULL;
+	// Size every string up front, so that they all go in one block
+	for (i = 0; i < count; i++)
+	{
+		if (fields[i].name == NULL || fields[i].value == NULL)
+		{
+			list->error = fields[i].name == NULL ? LHTTP_LIST_ERROR_KEY_NULL
+			                                     : LHTTP_LIST_ERROR_VALUE_NULL;
+			return LHTTP_LIST_ERROR;
+		}
 
-	return node;
-}
+		if (fields[i].name_len > UINT32_MAX ||
+		    fields[i].value_len > UINT32_MAX ||
+		    fields[i].name_len + fields[i].value_len + 2 > SIZE_MAX - total)
+		{
+			list->error = LHTTP_LIST_UNKNOWN_ERROR;
+			return LHTTP_LIST_ERROR;
+		}
 
-static inline void __lhttp_node_free(struct __lhttp_node_s *node)
-{
-	if (node->__key != NULL)
+		total += fields[i].name_len + fields[i].value_len + 2;
+	}
+
+	if (count == 0)
 	{
-		free(node->__key);
-		node->__key = NULL;
+		list->error = LHTTP_LIST_ERROR_NONE;
+		return LHTTP_LIST_OK;
 	}
 
-	if (node->__value != NULL)
+	if (total > SIZE_MAX - sizeof(*block))
 	{
-		free(node->__value);
-		node->__value = NULL;
+		list->error = LHTTP_LIST_UNKNOWN_ERROR;
+		return LHTTP_LIST_ERROR;
 	}
 
-	free(node);
-}
+	block = __lhttp_malloc(list->__allocator, sizeof(*block) + total);
+	if (block == NULL || __lhttp_list_reserve(list, count) != 0)
+	{
+		__lhttp_free(list->__allocator, block, sizeof(*block) + total);
 
-lhttp_list_status_t lhttp_list_init(lhttp_list_t *list)
-{
-	list->state = LHTTP_LIST_UNSET;
-	list->error = LHTTP_LIST_ERROR_NONE;
+		list->error = LHTTP_LIST_ERROR_MEMORY_ALLOCATION;
+		return LHTTP_LIST_ERROR;
+	}
+
+	block->__size = total;
+	data          = (char *)(block + 1);
+	start         = list->__count;
 
-	list->__head = __lhttp_node_create();
-	MEMCHECK_ALLOC_STRING(list->__head);
+	// Every entry now has room, so each one is a copy and a placement
+	for (i = 0; i < count; i++)
+	{
+		const lhttp_list_field_t *field = &fields[i];
 
-	list->__tail = list->__head;
-	list->__size = 0;
+		hash = __lhttp_list_hash(list, field->name, field->name_len);
+		head = __lhttp_list_find(
+		    list,
+		    field->name,
+		    field->name_len,
+		    hash,
+		    &pos
+		);
 
-	list->state = LHTTP_LIST_INITIALIZED;
+		if (head != LHTTP_LIST_NPOS && !(list->__flags & LHTTP_LIST_MULTIMAP))
+		{
+			__lhttp_list_unwind(list, start);
+			__lhttp_free(list->__allocator, block, sizeof(*block) + total);
 
-	return LHTTP_LIST_OK;
-}
+			list->error = LHTTP_LIST_ERROR_KEY_EXISTS;
+			return LHTTP_LIST_ERROR;
+		}
 
-lhttp_list_status_t
-lhttp_list_add(lhttp_list_t *list, const char *key, const char *value)
-{
-	if (list->state != LHTTP_LIST_INITIALIZED)
-	{
-		list->error = LHTTP_LIST_ERROR_NOT_INITIALIZED;
-		return LHTTP_LIST_ERROR;
-	}
+		entry = &__lhttp_list_entries(list)[list->__count];
 
-	struct __lhttp_node_s *node = __lhttp_node_create();
-	MEMCHECK_ALLOC_STRING(node);
+		entry->__key = data;
+		memcpy(data, field->name, field->name_len);
+		data[field->name_len] = '\0';
+		data += field->name_len + 1;
 
-	LHTTP_LIST_FOREACH(list, key, {
-		list->error = LHTTP_LIST_ERROR_KEY_EXISTS;
-		return LHTTP_LIST_ERROR;
-	});
+		entry->__value = data;
+		memcpy(data, field->value, field->value_len);
+		data[field->value_len] = '\0';
+		data += field->value_len + 1;
 
-	node->__key = strdup(key);
-	MEMCHECK_ALLOC_STRING(node->__key);
+		// The block is freed as a whole with the list
+		entry->__key_len   = field->name_len;
+		entry->__value_len = field->value_len;
+		entry->__hash      = hash;
+		entry->__owned     = 0;
+		entry->__next      = 0;
 
-	node->__value = strdup(value);
-	MEMCHECK_ALLOC_STRING(node->__value);
+		if (list->__entries == NULL)
+		{
+			list->__small_hashes[list->__count] = hash;
+		}
 
-	// Append the node to the list
-	list->__tail->__next = node;
-	list->__tail         = list->__tail->__next;
-	list->__size++;
+		if (head != LHTTP_LIST_NPOS)
+		{
+			__lhttp_list_chain(list, head, pos, list->__count);
+		}
+		else if (list->__slots != NULL)
+		{
+			__lhttp_list_place(list, hash, list->__count);
+		}
 
+		list->__count++;
+		list->__size++;
+	}
+
+	block->__next  = list->__blocks;
+	list->__blocks = block;
+
+	list->error = LHTTP_LIST_ERROR_NONE;
 	return LHTTP_LIST_OK;
 }
 
 lhttp_list_status_t
 lhttp_list_get(lhttp_list_t *list, const char *key, char **value)
 {
-	if (list->state != LHTTP_LIST_INITIALIZED)
+	const char *found;
+	lhttp_list_status_t s;
+
+	s = lhttp_list_get_n(
+	    list,
+	    key,
+	    key != NULL ? strlen(key) : 0,
+	    value != NULL ? &found : NULL,
+	    NULL
+	);
+
+	if (value != NULL)
+	{
+		*value = (char *)found;
+	}
+
+	return s;
+}
+
+lhttp_list_status_t lhttp_list_get_n(
+    lhttp_list_t *list,
+    const char *key,
+    size_t key_len,
+    const char **value,
+    size_t *value_len
+)
+{
+	const struct __lhttp_entry_s *entry;
+	size_t pos, index;
+	uint32_t hash;
+
+	if (!__lhttp_list_readable(list))
 	{
 		list->error = LHTTP_LIST_ERROR_NOT_INITIALIZED;
 		return LHTTP_LIST_ERROR;
 	}
 
-	LHTTP_LIST_FOREACH(list, key, {
+	if (key == NULL)
+	{
+		list->error = LHTTP_LIST_ERROR_KEY_NULL;
+		return LHTTP_LIST_ERROR;
+	}
+
+	hash  = __lhttp_list_hash(list, key, key_len);
+	index = __lhttp_list_find(list, key, key_len, hash, &pos);
+
+	if (index != LHTTP_LIST_NPOS)
+	{
+		entry = &__lhttp_list_entries(list)[index];
+
 		if (value != NULL)
-			*value = current->__value;
+			*value = entry->__value;
+
+		if (value_len != NULL)
+			*value_len = entry->__value_len;
 
 		list->error = LHTTP_LIST_ERROR_NONE;
 		return LHTTP_LIST_OK;
-	});
+	}
 
 	if (value != NULL)
 	{
@@ -137,66 +1165,430 @@ lhttp_list_get(lhttp_list_t *list, const char *key, char **value)
 		list->error = LHTTP_LIST_ERROR_NONE;
 	}
 
+	if (value_len != NULL)
+	{
+		*value_len = 0;
+	}
+
 	return LHTTP_LIST_ERROR;
 }
 
 lhttp_list_status_t lhttp_list_remove(lhttp_list_t *list, const char *key)
 {
+	return lhttp_list_remove_n(list, key, key != NULL ? strlen(key) : 0);
+}
+
+lhttp_list_status_t
+lhttp_list_remove_n(lhttp_list_t *list, const char *key, size_t key_len)
+{
+	struct __lhttp_entry_s *entries;
+	size_t pos = 0, next, index;
+	uint32_t hash;
+
 	if (list->state != LHTTP_LIST_INITIALIZED)
 	{
+		list->error = __lhttp_list_state_error(list);
+		return LHTTP_LIST_ERROR;
+	}
+
+	if (key == NULL)
+	{
+		list->error = LHTTP_LIST_ERROR_KEY_NULL;
+		return LHTTP_LIST_ERROR;
+	}
+
+	hash  = __lhttp_list_hash(list, key, key_len);
+	index = __lhttp_list_find(list, key, key_len, hash, &pos);
+
+	if (index == LHTTP_LIST_NPOS)
+	{
+		list->error = LHTTP_LIST_ERROR_KEY_NOT_FOUND;
+		return LHTTP_LIST_ERROR;
+	}
+
+	// Entries keep their place to preserve the order of the others. Every
+	// entry of a repeated key goes.
+	entries = __lhttp_list_entries(list);
+	do
+	{
+		next = entries[index].__next;
+
+		__lhttp_list_release(list, &entries[index]);
+		list->__size--;
+
+		index = next - 1;
+	} while (next != 0);
+
+	// Holes at the end are simply dropped
+	while (list->__count > 0 && entries[list->__count - 1].__key == NULL)
+	{
+		list->__count--;
+	}
+
+	if (list->__slots != NULL)
+	{
+		__lhttp_list_unplace(list, pos);
+	}
+
+	list->error = LHTTP_LIST_ERROR_NONE;
+	return LHTTP_LIST_OK;
+}
+
+lhttp_list_status_t lhttp_list_match_begin(
+    lhttp_list_t *list,
+    const char *key,
+    size_t key_len,
+    lhttp_list_match_t *match
+)
+{
+	size_t pos, index;
+	uint32_t hash;
+
+	match->__list = list;
+	match->__next = 0;
+
+	if (!__lhttp_list_readable(list))
+	{
+		list->error = LHTTP_LIST_ERROR_NOT_INITIALIZED;
+		return LHTTP_LIST_ERROR;
+	}
+
+	if (key == NULL)
+	{
+		list->error = LHTTP_LIST_ERROR_KEY_NULL;
+		return LHTTP_LIST_ERROR;
+	}
+
+	hash  = __lhttp_list_hash(list, key, key_len);
+	index = __lhttp_list_find(list, key, key_len, hash, &pos);
+
+	if (index == LHTTP_LIST_NPOS)
+	{
+		list->error = LHTTP_LIST_ERROR_KEY_NOT_FOUND;
+		return LHTTP_LIST_ERROR;
+	}
+
+	match->__next = index + 1;
+
+	list->error = LHTTP_LIST_ERROR_NONE;
+	return LHTTP_LIST_OK;
+}
+
+bool lhttp_list_match_next(
+    lhttp_list_match_t *match,
+    const char **value,
+    size_t *value_len
+)
+{
+	const struct __lhttp_entry_s *entry;
+
+	if (match->__next == 0)
+	{
+		return false;
+	}
+
+	// Only the chain of the key is followed, other entries are never read
+	entry         = &__lhttp_list_entries(match->__list)[match->__next - 1];
+	match->__next = entry->__next;
+
+	if (value != NULL)
+		*value = entry->__value;
+
+	if (value_len != NULL)
+		*value_len = entry->__value_len;
+
+	return true;
+}
+
+lhttp_list_status_t
+lhttp_list_iter_begin(lhttp_list_t *list, lhttp_list_iter_t *iter)
+{
+	iter->__list  = list;
+	iter->__index = 0;
+
+	if (!__lhttp_list_readable(list))
+	{
+		// Nothing is visited on a list that is not initialized
+		iter->__list = NULL;
+
 		list->error = LHTTP_LIST_ERROR_NOT_INITIALIZED;
 		return LHTTP_LIST_ERROR;
 	}
 
-	struct __lhttp_node_s *prev = list->__head;
-	struct __lhttp_node_s *curr = list->__head->__next;
+	list->error = LHTTP_LIST_ERROR_NONE;
+	return LHTTP_LIST_OK;
+}
+
+bool lhttp_list_iter_next(
+    lhttp_list_iter_t *iter,
+    const char **key,
+    size_t *key_len,
+    const char **value,
+    size_t *value_len
+)
+{
+	const struct __lhttp_entry_s *entries, *entry;
+	size_t ahead;
+
+	if (iter->__list == NULL)
+	{
+		return false;
+	}
+
+	entries = __lhttp_list_entries(iter->__list);
+
+	// Skip the holes left by removed entries
+	while (iter->__index < iter->__list->__count &&
+	       entries[iter->__index].__key == NULL)
+	{
+		iter->__index++;
+	}
+
+	if (iter->__index >= iter->__list->__count)
+	{
+		return false;
+	}
+
+	entry = &entries[iter->__index++];
+
+	// The entries themselves are read in order, but their strings are
+	// scattered: fetch those of a later entry while this one is used
+	ahead = iter->__index + LHTTP_LIST_PREFETCH_DISTANCE - 1;
+	if (ahead < iter->__list->__count)
+	{
+		LHTTP_LIST_PREFETCH(entries[ahead].__key);
+		LHTTP_LIST_PREFETCH(entries[ahead].__value);
+	}
+
+	if (key != NULL)
+		*key = entry->__key;
+
+	if (key_len != NULL)
+		*key_len = entry->__key_len;
+
+	if (value != NULL)
+		*value = entry->__value;
+
+	if (value_len != NULL)
+		*value_len = entry->__value_len;
+
+	return true;
+}
+
+/**
+ * @brief Order index slots by hash, then by entry index
+ */
+static int __lhttp_list_slot_cmp(const void *a, const void *b)
+{
+	const struct __lhttp_slot_s *x = a;
+	const struct __lhttp_slot_s *y = b;
+
+	if (x->__hash != y->__hash)
+	{
+		return x->__hash < y->__hash ? -1 : 1;
+	}
+
+	return (x->__index > y->__index) - (x->__index < y->__index);
+}
+
+/**
+ * @brief Rebuild the chains of repeated keys from the sorted keys of a
+ * frozen list, where the entries of a key are next to each other
+ */
+static void __lhttp_list_frozen_relink(lhttp_list_t *list)
+{
+	const struct __lhttp_slot_s *keys = list->__slots;
+	struct __lhttp_entry_s *entries   = list->__entries;
+	size_t i, j;
+
+	for (i = 0; i < list->__count; i++)
+	{
+		entries[i].__next = 0;
+	}
 
-	while (curr != NULL)
+	// Keys with the same hash are sorted by index, so the next entry of a
+	// key is the first match after it, almost always the very next one
+	for (i = 1; i <= list->__mask; i++)
 	{
-		if (curr->__key == NULL)
+		struct __lhttp_entry_s *entry = &entries[keys[i].__index - 1];
+
+		for (j = i + 1; j <= list->__mask && keys[j].__hash == keys[i].__hash;
+		     j++)
 		{
-			list->error = LHTTP_LIST_ERROR_KEY_NULL;
-			return LHTTP_LIST_ERROR;
+			if (__lhttp_list_match(
+			        list,
+			        &entries[keys[j].__index - 1],
+			        entry->__key,
+			        entry->__key_len
+			    ))
+			{
+				entry->__next = keys[j].__index;
+				break;
+			}
 		}
+	}
+}
+
+lhttp_list_status_t lhttp_list_freeze(lhttp_list_t *list)
+{
+	struct __lhttp_slot_s *keys, *sorted = NULL;
+	struct __lhttp_entry_s *entries;
+	size_t i, k, n;
+
+	if (list->state == LHTTP_LIST_FROZEN)
+	{
+		return LHTTP_LIST_OK;
+	}
+
+	if (list->state != LHTTP_LIST_INITIALIZED)
+	{
+		list->error = LHTTP_LIST_ERROR_NOT_INITIALIZED;
+		return LHTTP_LIST_ERROR;
+	}
+
+	// Inline entries are already dense and scanned, compacting is enough
+	if (list->__entries == NULL)
+	{
+		__lhttp_list_compact(list);
+
+		list->state = LHTTP_LIST_FROZEN;
+		return LHTTP_LIST_OK;
+	}
+
+	// Every entry is a key of the array, repeated ones included: the first
+	// match of a key is then its first entry. Everything is allocated
+	// before the list is touched, so that a failure leaves it as it was.
+	n    = list->__size;
+	keys = __lhttp_malloc(list->__allocator, (n + 1) * sizeof(*keys));
 
-		if (strcmp(curr->__key, key) == 0)
+	if (n > LHTTP_LIST_EYTZINGER_MIN && keys != NULL)
+	{
+		sorted = __lhttp_malloc(list->__allocator, n * sizeof(*sorted));
+		if (sorted == NULL)
 		{
-			printf("key: %s,%s\n", curr->__key, key);
-			prev->__next = curr->__next;
-			__lhttp_node_free(curr);
-			list->__size--;
+			__lhttp_free(list->__allocator, keys, (n + 1) * sizeof(*keys));
+			keys = NULL;
+		}
+	}
+
+	if (keys == NULL)
+	{
+		list->error = LHTTP_LIST_ERROR_MEMORY_ALLOCATION;
+		return LHTTP_LIST_ERROR;
+	}
+
+	__lhttp_list_compact(list);
 
-			list->error = LHTTP_LIST_ERROR_NONE;
-			return LHTTP_LIST_OK;
+	keys[0].__hash  = 0;
+	keys[0].__index = 0;
+
+	for (i = 0; i < n; i++)
+	{
+		keys[i + 1].__hash  = list->__entries[i].__hash;
+		keys[i + 1].__index = i + 1;
+	}
+
+	qsort(keys + 1, n, sizeof(*keys), __lhttp_list_slot_cmp);
+
+	__lhttp_free(
+	    list->__allocator,
+	    list->__slots,
+	    (list->__mask + 1) * sizeof(*keys)
+	);
+
+	list->__slots = keys;
+	list->__mask  = n;
+
+	// The chains pointed at indices from before the compaction
+	if (list->__flags & LHTTP_LIST_MULTIMAP)
+	{
+		__lhttp_list_frozen_relink(list);
+	}
+
+	if (sorted != NULL)
+	{
+		// An in-order walk of the implicit tree visits the positions in
+		// sorted order, starting from the leftmost one
+		memcpy(sorted, keys + 1, n * sizeof(*sorted));
+
+		for (k = 1; 2 * k <= n; k *= 2)
+			;
+
+		for (i = 0; i < n; i++, k = __lhttp_list_eytzinger_next(k, n))
+		{
+			keys[k] = sorted[i];
 		}
 
-		prev = curr;
-		curr = curr->__next;
+		__lhttp_free(list->__allocator, sorted, n * sizeof(*sorted));
 	}
 
-	list->error = LHTTP_LIST_ERROR_KEY_NOT_FOUND;
-	return LHTTP_LIST_ERROR;
+	// Nothing is added anymore, the spare entries can go back
+	if (n > 0 && n < list->__capacity)
+	{
+		entries = __lhttp_realloc(
+		    list->__allocator,
+		    list->__entries,
+		    list->__capacity * sizeof(*entries),
+		    n * sizeof(*entries)
+		);
+
+		if (entries != NULL)
+		{
+			list->__entries  = entries;
+			list->__capacity = n;
+		}
+	}
+
+	list->state = LHTTP_LIST_FROZEN;
+	return LHTTP_LIST_OK;
 }
 
 void lhttp_list_free(lhttp_list_t *list)
 {
-	if (list->state == LHTTP_LIST_INITIALIZED)
+	const lhttp_allocator_t *a;
+	size_t i;
+
+	if (__lhttp_list_readable(list))
 	{
-		struct __lhttp_node_s *node = list->__head->__next;
-		struct __lhttp_node_s *next = NULL;
+		a = list->__allocator;
+
+		for (i = 0; i < list->__count; i++)
+		{
+			__lhttp_list_release(list, &__lhttp_list_entries(list)[i]);
+		}
+
+		if (list->__entries != NULL)
+		{
+			__lhttp_free(
+			    a,
+			    list->__entries,
+			    list->__capacity * sizeof(struct __lhttp_entry_s)
+			);
+		}
+
+		if (list->__slots != NULL)
+		{
+			__lhttp_free(
+			    a,
+			    list->__slots,
+			    (list->__mask + 1) * sizeof(struct __lhttp_slot_s)
+			);
+		}
 
-		while (node != NULL)
+		while (list->__blocks != NULL)
 		{
-			next = node->__next;
+			struct __lhttp_list_block_s *block = list->__blocks;
 
-			__lhttp_node_free(node);
-			node = next;
+			list->__blocks = block->__next;
+			__lhttp_free(a, block, sizeof(*block) + block->__size);
 		}
 
-		free(list->__head);
-		list->__head = NULL;
-		list->__tail = NULL;
-		list->__size = 0;
+		list->__entries  = NULL;
+		list->__count    = 0;
+		list->__capacity = LHTTP_LIST_INLINE_SIZE;
+		list->__slots    = NULL;
+		list->__mask     = 0;
+		list->__size     = 0;
 	}
 
 	list->state = LHTTP_LIST_UNSET;
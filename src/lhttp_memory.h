@@ -0,0 +1,69 @@
+/* src/lhttp_memory.h
+ *
+ * Copyright (c) 2024 libhttp. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/* Private helpers to allocate through an `lhttp_allocator_t`. This header is
+ * not part of the public API and is not installed. */
+
+#ifndef LIBHTTP_MEMORY_H
+#define LIBHTTP_MEMORY_H 1
+
+#include <lhttp_allocator.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Get the allocator to use, `lhttp_allocator_libc` if `a` is NULL
+ */
+static inline const lhttp_allocator_t *
+__lhttp_allocator(const lhttp_allocator_t *a)
+{
+	return a != NULL ? a : &lhttp_allocator_libc;
+}
+
+static inline void *__lhttp_malloc(const lhttp_allocator_t *a, size_t size)
+{
+	return a->malloc_fn(a->ctx, size);
+}
+
+static inline void *__lhttp_realloc(
+    const lhttp_allocator_t *a,
+    void *ptr,
+    size_t old_size,
+    size_t new_size
+)
+{
+	// Allocators only ever resize blocks they handed out
+	if (ptr == NULL)
+		return a->malloc_fn(a->ctx, new_size);
+
+	return a->realloc_fn(a->ctx, ptr, old_size, new_size);
+}
+
+static inline void
+__lhttp_free(const lhttp_allocator_t *a, void *ptr, size_t size)
+{
+	if (ptr != NULL)
+		a->free_fn(a->ctx, ptr, size);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LIBHTTP_MEMORY_H
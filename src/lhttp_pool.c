@@ -0,0 +1,370 @@
+/* Copyright (c) 2024 libhttp. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <lhttp_pool.h>
+
+#include <stdint.h>
+#include <string.h>
+
+#include "lhttp_memory.h"
+
+/* Blocks and slab headers are padded to keep every block aligned */
+#define LHTTP_POOL_ROUND(size)                                                \
+	(((size) + (LHTTP_POOL_ALIGN - 1)) & ~(size_t)(LHTTP_POOL_ALIGN - 1))
+
+#define LHTTP_POOL_HEADER LHTTP_POOL_ROUND(sizeof(struct __lhttp_pool_slab_s))
+
+static inline size_t __lhttp_pool_slab_size(const lhttp_pool_t *pool)
+{
+	return LHTTP_POOL_HEADER + pool->__block_size * pool->__batch;
+}
+
+int lhttp_pool_init(
+    lhttp_pool_t *pool,
+    size_t block_size,
+    size_t batch,
+    const lhttp_allocator_t *backing
+)
+{
+	if (pool == NULL || block_size > SIZE_MAX / 2)
+	{
+		return -1;
+	}
+
+	if (block_size < sizeof(struct __lhttp_pool_block_s))
+	{
+		block_size = sizeof(struct __lhttp_pool_block_s);
+	}
+
+	pool->__backing    = __lhttp_allocator(backing);
+	pool->__block_size = LHTTP_POOL_ROUND(block_size);
+	pool->__batch      = batch > 0 ? batch : LHTTP_POOL_BATCH;
+	pool->__full       = NULL;
+	pool->__loose      = NULL;
+	pool->__slabs      = NULL;
+
+	if (pool->__batch > (SIZE_MAX - LHTTP_POOL_HEADER) / pool->__block_size)
+	{
+		return -1;
+	}
+
+	if (pthread_mutex_init(&pool->__lock, NULL) != 0)
+	{
+		return -1;
+	}
+
+	return 0;
+}
+
+void lhttp_pool_free(lhttp_pool_t *pool)
+{
+	struct __lhttp_pool_slab_s *slab = pool->__slabs;
+	struct __lhttp_pool_slab_s *next = NULL;
+
+	while (slab != NULL)
+	{
+		next = slab->__next;
+		__lhttp_free(pool->__backing, slab, __lhttp_pool_slab_size(pool));
+		slab = next;
+	}
+
+	pool->__full  = NULL;
+	pool->__loose = NULL;
+	pool->__slabs = NULL;
+
+	pthread_mutex_destroy(&pool->__lock);
+}
+
+/**
+ * @brief Carve a new slab into a batch of free blocks
+ *
+ * @return The first block of the batch, or NULL on failure
+ */
+static struct __lhttp_pool_block_s *__lhttp_pool_slab(lhttp_pool_t *pool)
+{
+	struct __lhttp_pool_slab_s *slab;
+	struct __lhttp_pool_block_s *block;
+	char *data;
+	size_t i;
+
+	// The backing allocator is called outside of the lock
+	slab = __lhttp_malloc(pool->__backing, __lhttp_pool_slab_size(pool));
+	if (slab == NULL)
+	{
+		return NULL;
+	}
+
+	// Link the blocks in address order
+	data  = (char *)slab + LHTTP_POOL_HEADER;
+	block = (struct __lhttp_pool_block_s *)data;
+	for (i = 1; i < pool->__batch; i++)
+	{
+		block->__next = (void *)((char *)block + pool->__block_size);
+		block         = block->__next;
+	}
+
+	block->__next = NULL;
+
+	pthread_mutex_lock(&pool->__lock);
+	slab->__next  = pool->__slabs;
+	pool->__slabs = slab;
+	pthread_mutex_unlock(&pool->__lock);
+
+	return (struct __lhttp_pool_block_s *)data;
+}
+
+/**
+ * @brief Refill an empty cache with a batch from its pool
+ *
+ * @return 0 on success, -1 on failure
+ */
+static int __lhttp_pool_cache_refill(lhttp_pool_cache_t *cache)
+{
+	lhttp_pool_t *pool                = cache->__pool;
+	struct __lhttp_pool_block_s *head = NULL;
+	size_t count                      = 0;
+
+	pthread_mutex_lock(&pool->__lock);
+
+	if (pool->__full != NULL)
+	{
+		// A whole batch is a single pop
+		head         = pool->__full;
+		pool->__full = head->__batch;
+		count        = pool->__batch;
+	}
+	else
+	{
+		// Blocks of partial batches are taken one by one, which only
+		// happens after caches were released
+		while (pool->__loose != NULL && count < pool->__batch)
+		{
+			struct __lhttp_pool_block_s *block = pool->__loose;
+
+			pool->__loose = block->__next;
+			block->__next = head;
+			head          = block;
+			count++;
+		}
+	}
+
+	pthread_mutex_unlock(&pool->__lock);
+
+	if (head == NULL)
+	{
+		head = __lhttp_pool_slab(pool);
+		if (head == NULL)
+		{
+			return -1;
+		}
+
+		count = pool->__batch;
+	}
+
+	cache->__free  = head;
+	cache->__count = count;
+
+	return 0;
+}
+
+/**
+ * @brief Give the first batch of blocks of a cache back to its pool
+ */
+static void __lhttp_pool_cache_drain(lhttp_pool_cache_t *cache)
+{
+	lhttp_pool_t *pool                = cache->__pool;
+	struct __lhttp_pool_block_s *head = cache->__free;
+	struct __lhttp_pool_block_s *tail = head;
+	size_t i;
+
+	// Detach the batch before taking the lock, so that it is held for a
+	// single push
+	for (i = 1; i < pool->__batch; i++)
+	{
+		tail = tail->__next;
+	}
+
+	cache->__free   = tail->__next;
+	cache->__count -= pool->__batch;
+	tail->__next    = NULL;
+
+	pthread_mutex_lock(&pool->__lock);
+	head->__batch = pool->__full;
+	pool->__full  = head;
+	pthread_mutex_unlock(&pool->__lock);
+}
+
+void *lhttp_pool_cache_alloc(lhttp_pool_cache_t *cache)
+{
+	struct __lhttp_pool_block_s *block;
+
+	if (cache->__free == NULL && __lhttp_pool_cache_refill(cache) != 0)
+	{
+		return NULL;
+	}
+
+	block         = cache->__free;
+	cache->__free = block->__next;
+	cache->__count--;
+
+	return block;
+}
+
+void lhttp_pool_cache_release(lhttp_pool_cache_t *cache, void *ptr)
+{
+	struct __lhttp_pool_block_s *block = ptr;
+
+	if (block == NULL)
+	{
+		return;
+	}
+
+	block->__next = cache->__free;
+	cache->__free = block;
+	cache->__count++;
+
+	// Keeping one batch at hand avoids going back and forth to the pool
+	// when a thread allocates and frees around a batch boundary
+	if (cache->__count >= 2 * cache->__pool->__batch)
+	{
+		__lhttp_pool_cache_drain(cache);
+	}
+}
+
+static void *__lhttp_pool_malloc(void *ctx, size_t size)
+{
+	lhttp_pool_cache_t *cache = ctx;
+
+	if (size > cache->__pool->__block_size)
+	{
+		return __lhttp_malloc(cache->__pool->__backing, size);
+	}
+
+	return lhttp_pool_cache_alloc(cache);
+}
+
+static void *
+__lhttp_pool_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size)
+{
+	lhttp_pool_cache_t *cache = ctx;
+	const size_t block_size   = cache->__pool->__block_size;
+	void *copy;
+
+	if (ptr == NULL)
+	{
+		return __lhttp_pool_malloc(cache, new_size);
+	}
+
+	// A block always has room for the whole block size
+	if (old_size <= block_size && new_size <= block_size)
+	{
+		return ptr;
+	}
+
+	if (old_size > block_size && new_size > block_size)
+	{
+		return __lhttp_realloc(
+		    cache->__pool->__backing,
+		    ptr,
+		    old_size,
+		    new_size
+		);
+	}
+
+	// Moving between the pool and the backing allocator
+	copy = __lhttp_pool_malloc(cache, new_size);
+	if (copy == NULL)
+	{
+		return NULL;
+	}
+
+	memcpy(copy, ptr, old_size < new_size ? old_size : new_size);
+
+	if (old_size > block_size)
+	{
+		__lhttp_free(cache->__pool->__backing, ptr, old_size);
+	}
+	else
+	{
+		lhttp_pool_cache_release(cache, ptr);
+	}
+
+	return copy;
+}
+
+static void __lhttp_pool_release(void *ctx, void *ptr, size_t size)
+{
+	lhttp_pool_cache_t *cache = ctx;
+
+	if (size > cache->__pool->__block_size)
+	{
+		__lhttp_free(cache->__pool->__backing, ptr, size);
+		return;
+	}
+
+	lhttp_pool_cache_release(cache, ptr);
+}
+
+int lhttp_pool_cache_init(lhttp_pool_cache_t *cache, lhttp_pool_t *pool)
+{
+	if (cache == NULL || pool == NULL)
+	{
+		return -1;
+	}
+
+	cache->__allocator.malloc_fn  = __lhttp_pool_malloc;
+	cache->__allocator.realloc_fn = __lhttp_pool_realloc;
+	cache->__allocator.free_fn    = __lhttp_pool_release;
+	cache->__allocator.ctx        = cache;
+
+	cache->__pool  = pool;
+	cache->__free  = NULL;
+	cache->__count = 0;
+
+	return 0;
+}
+
+const lhttp_allocator_t *lhttp_pool_cache_allocator(lhttp_pool_cache_t *cache)
+{
+	return &cache->__allocator;
+}
+
+void lhttp_pool_cache_free(lhttp_pool_cache_t *cache)
+{
+	lhttp_pool_t *pool = cache->__pool;
+	struct __lhttp_pool_block_s *tail;
+
+	while (cache->__count >= pool->__batch)
+	{
+		__lhttp_pool_cache_drain(cache);
+	}
+
+	if (cache->__free == NULL)
+	{
+		return;
+	}
+
+	// The rest is not a whole batch, it joins the loose blocks
+	for (tail = cache->__free; tail->__next != NULL; tail = tail->__next)
+		;
+
+	pthread_mutex_lock(&pool->__lock);
+	tail->__next  = pool->__loose;
+	pool->__loose = cache->__free;
+	pthread_mutex_unlock(&pool->__lock);
+
+	cache->__free  = NULL;
+	cache->__count = 0;
+}
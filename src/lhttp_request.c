@@ -15,17 +15,58 @@
 
 #include <lhttp_request.h>
 
-#define CHECK_VALID_STRING(start, end)     \
-	if (end == NULL || (end - start) <= 0) \
-	{                                      \
-		return LHTTP_REQUEST_ERROR;        \
+#include "lhttp_char_class.h"
+#include "lhttp_header_hash.h"
+#include "lhttp_memory.h"
+#include "lhttp_scan.h"
+#include "lhttp_token.h"
+
+#define CHECK_VALID_STRING(request, start, end, err) \
+	if (end == NULL || (end - start) <= 0)           \
+	{                                                \
+		return __lhttp_request_fail(request, err);   \
 	}
 
+/* Private parser states kept in `request->__state`. Each state resumes at
+ * `request->__pos`, so bytes accepted by an earlier call are never scanned
+ * again, whatever the size of the chunks the message arrives in. */
+enum lhttp_request_state_e
+{
+	LHTTP_REQUEST_STATE_START,
+	LHTTP_REQUEST_STATE_METHOD,
+	LHTTP_REQUEST_STATE_SPACES_BEFORE_URI,
+	LHTTP_REQUEST_STATE_URI,
+	LHTTP_REQUEST_STATE_SPACES_BEFORE_VERSION,
+	LHTTP_REQUEST_STATE_VERSION,
+	LHTTP_REQUEST_STATE_REQUEST_LINE_LF,
+	LHTTP_REQUEST_STATE_HEADER_LINE_START,
+	LHTTP_REQUEST_STATE_HEADER_NAME,
+	LHTTP_REQUEST_STATE_SPACES_BEFORE_VALUE,
+	LHTTP_REQUEST_STATE_HEADER_VALUE,
+	LHTTP_REQUEST_STATE_HEADER_LINE_LF,
+	LHTTP_REQUEST_STATE_HEADERS_END_LF,
+	LHTTP_REQUEST_STATE_BODY_START,
+	LHTTP_REQUEST_STATE_BODY_IDENTITY,
+	LHTTP_REQUEST_STATE_CHUNK_SIZE_START,
+	LHTTP_REQUEST_STATE_CHUNK_SIZE,
+	LHTTP_REQUEST_STATE_CHUNK_EXTENSION,
+	LHTTP_REQUEST_STATE_CHUNK_SIZE_LF,
+	LHTTP_REQUEST_STATE_CHUNK_DATA,
+	LHTTP_REQUEST_STATE_CHUNK_DATA_CR,
+	LHTTP_REQUEST_STATE_CHUNK_DATA_LF,
+	LHTTP_REQUEST_STATE_TRAILER_LINE_START,
+	LHTTP_REQUEST_STATE_TRAILER_LINE,
+	LHTTP_REQUEST_STATE_TRAILER_LINE_LF,
+	LHTTP_REQUEST_STATE_TRAILER_END_LF,
+	LHTTP_REQUEST_STATE_DONE
+};
+
 /**
  * @brief Parse the request line of the HTTP request message string
  * 
  * @param request An existing HTTP request object
- * @return 0 on success, -1 on failure
+ * @return 0 when the request line is complete, `LHTTP_REQUEST_PARSING_ONGOING`
+ * when more data is needed, -1 on failure
  */
 static inline int __lhttp_request_parse_request_line(lhttp_request_t *request);
 
@@ -33,27 +74,88 @@ static inline int __lhttp_request_parse_request_line(lhttp_request_t *request);
  * @brief Parse the header section of the HTTP request message string
  * 
  * @param request An existing HTTP request object
- * @return 0 on success, -1 on failure
+ * @return 0 when the header section is complete,
+ * `LHTTP_REQUEST_PARSING_ONGOING` when more data is needed, -1 on failure
  */
 static inline int __lhttp_request_parse_headers(lhttp_request_t *request);
 
-int lhttp_request_init(lhttp_request_t *request, size_t size)
+/**
+ * @brief Find the end of the body of the HTTP request message string, from
+ * its Content-Length or its chunked framing
+ * 
+ * @param request An existing HTTP request object
+ * @return 0 when the message is complete, `LHTTP_REQUEST_PARSING_ONGOING`
+ * when more data is needed, -1 on failure
+ */
+static inline int __lhttp_request_parse_body(lhttp_request_t *request);
+
+/**
+ * @brief Mark the request as invalid with `error`
+ * 
+ * @param request An existing HTTP request object
+ * @param error The error to report
+ * @return -1, so that callers can return the result directly
+ */
+static inline int
+__lhttp_request_fail(lhttp_request_t *request, int error)
 {
-	request->status = LHTTP_REQUEST_UNSET;
+	request->status = LHTTP_REQUEST_ERROR;
+	request->error  = error;
+
+	return LHTTP_REQUEST_ERROR;
+}
 
-	// Allocate memory for the buffer of request message
-	request->__buf     = calloc(size, sizeof(char));
-	request->__buf_len = size;
+/**
+ * @brief Save the position `p` of the next byte to look at and ask for more
+ * 
+ * @param request An existing HTTP request object
+ * @param p First byte that has not been accepted yet
+ * @return `LHTTP_REQUEST_PARSING_ONGOING`
+ */
+static inline int
+__lhttp_request_need_more(lhttp_request_t *request, const char *p)
+{
+	request->__pos = p - request->__data;
 
-	if (request->__buf == NULL)
-	{
-		request->status = LHTTP_REQUEST_ERROR;
-		request->error  = LHTTP_REQUEST_ERROR_MEMORY_ALLOCATION;
+	return LHTTP_REQUEST_PARSING_ONGOING;
+}
 
-		return LHTTP_REQUEST_ERROR;
-	}
+/**
+ * @brief Get the error reported when the message outgrows the buffer while
+ * the parser is in `state`
+ */
+static inline int __lhttp_request_too_large_error(int state)
+{
+	if (state <= LHTTP_REQUEST_STATE_METHOD)
+		return LHTTP_REQUEST_ERROR_TOO_LARGE | LHTTP_REQUEST_ERROR_METHOD;
 
-	request->error = LHTTP_REQUEST_ERROR_NONE;
+	if (state <= LHTTP_REQUEST_STATE_URI)
+		return LHTTP_REQUEST_ERROR_TOO_LARGE | LHTTP_REQUEST_ERROR_URI;
+
+	if (state <= LHTTP_REQUEST_STATE_REQUEST_LINE_LF)
+		return LHTTP_REQUEST_ERROR_TOO_LARGE | LHTTP_REQUEST_REQUEST_LINE;
+
+	if (state <= LHTTP_REQUEST_STATE_HEADERS_END_LF)
+		return LHTTP_REQUEST_ERROR_TOO_LARGE | LHTTP_REQUEST_ERROR_HEADERS;
+
+	return LHTTP_REQUEST_ERROR_TOO_LARGE | LHTTP_REQUEST_ERROR_BODY;
+}
+
+/**
+ * @brief Reset the parser and every marker of the request
+ * 
+ * @param request An existing HTTP request object
+ */
+static inline void __lhttp_request_clear(lhttp_request_t *request)
+{
+	request->error   = LHTTP_REQUEST_ERROR_NONE;
+	request->method  = LHTTP_METHOD_INVALID;
+	request->version = LHTTP_VERSION_INVALID;
+
+	request->__data_len       = 0;
+	request->__state          = LHTTP_REQUEST_STATE_START;
+	request->__pos            = 0;
+	request->__body_remaining = 0;
 
 	request->__request_line_start = NULL;
 	request->__request_line_end   = NULL;
@@ -68,13 +170,114 @@ int lhttp_request_init(lhttp_request_t *request, size_t size)
 	request->__body_start         = NULL;
 	request->__body_end           = NULL;
 
+	request->uri      = NULL;
+	request->uri_len  = 0;
+	request->uri_form = LHTTP_URI_FORM_INVALID;
+	memset(request->__uri_parts, 0, sizeof(request->__uri_parts));
+	request->__uri_decoded = 0;
+
+	// Slices past the count are never read, so they are left as they are
+	request->__header_count   = 0;
+	request->__header_illegal = 0;
+	memset(request->__known_headers, 0, sizeof(request->__known_headers));
+
 	request->status = LHTTP_REQUEST_PARSING_INITIALIZED;
+}
+
+int lhttp_request_init(lhttp_request_t *request, size_t size)
+{
+	return lhttp_request_init_with_allocator(request, size, NULL);
+}
+
+int lhttp_request_init_with_allocator(
+    lhttp_request_t *request,
+    size_t size,
+    const lhttp_allocator_t *allocator
+)
+{
+	request->status      = LHTTP_REQUEST_UNSET;
+	request->__allocator = __lhttp_allocator(allocator);
+
+	// Allocate memory for the buffer of request message. One extra byte keeps
+	// the buffered message NUL-terminated. The buffer is not zeroed: the
+	// parser never reads past the bytes it was given.
+	request->__buf      = __lhttp_malloc(request->__allocator, size + 1);
+	request->__buf_len  = size;
+	request->__data     = request->__buf;
+	request->__borrowed = false;
+
+	if (request->__buf == NULL)
+	{
+		request->status = LHTTP_REQUEST_ERROR;
+		request->error  = LHTTP_REQUEST_ERROR_MEMORY_ALLOCATION;
+
+		return LHTTP_REQUEST_ERROR;
+	}
+
+	request->__buf[0] = '\0';
+	__lhttp_request_clear(request);
+
+	return LHTTP_REQUEST_OK;
+}
+
+int lhttp_request_init_borrowed(lhttp_request_t *request, size_t size)
+{
+	// Nothing is allocated: the message stays in the caller's buffer, which
+	// is only known once the first chunk is passed to `lhttp_request_parse`
+	request->__buf       = NULL;
+	request->__buf_len   = size;
+	request->__data      = NULL;
+	request->__borrowed  = true;
+	request->__allocator = &lhttp_allocator_libc;
+
+	__lhttp_request_clear(request);
+
+	return LHTTP_REQUEST_OK;
+}
+
+int lhttp_request_reset(lhttp_request_t *request)
+{
+	if (request == NULL)
+	{
+		return LHTTP_REQUEST_ERROR;
+	}
+
+	if (request->__borrowed)
+	{
+		// The next message may live anywhere in the caller's memory
+		request->__data = NULL;
+	}
+	else
+	{
+		// A request that was freed, or never got its buffer, has nothing to
+		// reuse
+		if (request->__buf == NULL)
+		{
+			return LHTTP_REQUEST_ERROR;
+		}
+
+		request->__data   = request->__buf;
+		request->__buf[0] = '\0';
+	}
+
+	__lhttp_request_clear(request);
 
 	return LHTTP_REQUEST_OK;
 }
 
 int lhttp_request_parse(lhttp_request_t *request, const char *buf, size_t size)
 {
+	return lhttp_request_parse_stream(request, buf, size, NULL);
+}
+
+int lhttp_request_parse_stream(
+    lhttp_request_t *request,
+    const char *buf,
+    size_t size,
+    size_t *consumed
+)
+{
+	size_t room, received;
 	int s;
 
 	if (request == NULL || buf == NULL)
@@ -82,85 +285,1458 @@ int lhttp_request_parse(lhttp_request_t *request, const char *buf, size_t size)
 		return LHTTP_REQUEST_ERROR;
 	}
 
-	// Copy the buffer into the request
-	memcpy(request->__buf, buf, size);
+	// Only a fresh request or one waiting for more data can take a chunk
+	if (request->status != LHTTP_REQUEST_PARSING_INITIALIZED &&
+	    request->status != LHTTP_REQUEST_PARSING_ONGOING)
+	{
+		return LHTTP_REQUEST_ERROR;
+	}
+
+	// Take as much of the chunk as the buffer can hold
+	received = request->__data_len;
+	room     = request->__buf_len - request->__data_len;
+	if (size > room)
+	{
+		size = room;
+	}
+
+	if (request->__borrowed)
+	{
+		// A borrowed message is indexed in place, so every chunk must follow
+		// the previous one in the caller's buffer
+		if (request->__data == NULL)
+		{
+			request->__data = buf;
+		}
+		else if (buf != request->__data + request->__data_len)
+		{
+			return LHTTP_REQUEST_ERROR;
+		}
+
+		request->__data_len += size;
+	}
+	else
+	{
+		memcpy(request->__buf + request->__data_len, buf, size);
+		request->__data_len                += size;
+		request->__buf[request->__data_len] = '\0';
+	}
+
+	request->status = LHTTP_REQUEST_PARSING_ONGOING;
 
 	s = __lhttp_request_parse_request_line(request);
 
-	if (s != 0)
+	if (s == 0)
 	{
-		return LHTTP_REQUEST_ERROR;
+		s = __lhttp_request_parse_headers(request);
+	}
+
+	if (s == 0)
+	{
+		s = __lhttp_request_parse_body(request);
 	}
 
-	s = __lhttp_request_parse_headers(request);
+	if (s == LHTTP_REQUEST_PARSING_ONGOING &&
+	    request->__data_len == request->__buf_len)
+	{
+		// The message cannot complete within the buffer size given at init
+		int error = __lhttp_request_too_large_error(request->__state);
+		return __lhttp_request_fail(request, error);
+	}
 
 	if (s != 0)
 	{
-		return LHTTP_REQUEST_ERROR;
+		if (consumed != NULL)
+		{
+			*consumed = s == LHTTP_REQUEST_PARSING_ONGOING ? size : 0;
+		}
+
+		return s;
+	}
+
+	// Whatever follows the message belongs to the next one: it is given back
+	// to the caller and dropped from the request
+	request->__data_len = request->__pos;
+	if (!request->__borrowed)
+	{
+		request->__buf[request->__data_len] = '\0';
 	}
 
+	if (consumed != NULL)
+	{
+		*consumed = request->__data_len - received;
+	}
+
+	request->status = LHTTP_REQUEST_PARSING_DONE;
+
 	return LHTTP_REQUEST_OK;
 }
 
-static inline int __lhttp_request_parse_request_line(lhttp_request_t *request)
+/**
+ * @brief Skip the bytes of `[p, end)` that belong to one of the classes in
+ * `mask`
+ * 
+ * @return The first byte outside of the classes, or `end`
+ */
+static inline const char *
+__lhttp_request_span(const char *p, const char *end, unsigned char mask)
+{
+	for (; p < end && (__lhttp_char_class[(unsigned char)*p] & mask); p++)
+		;
+
+	return p;
+}
+
+/**
+ * @brief Record `[p, end)` as the `part` component of the URI
+ */
+static inline void __lhttp_request_uri_slice(
+    lhttp_request_t *request,
+    lhttp_uri_part_t part,
+    const char *p,
+    const char *end
+)
+{
+	request->__uri_parts[part].offset = p - request->__data;
+	request->__uri_parts[part].length = end - p;
+}
+
+/**
+ * @brief Get the delimiters left to look for in the URI: once the query has
+ * started, '?' is an ordinary byte, and so is '#' in the fragment
+ */
+static inline const char *
+__lhttp_request_uri_delimiters(const lhttp_request_t *request)
+{
+	if (request->__uri_parts[LHTTP_URI_FRAGMENT].offset != 0)
+		return " \r\n";
+
+	if (request->__uri_parts[LHTTP_URI_QUERY].offset != 0)
+		return " \r\n#";
+
+	return " \r\n?#";
+}
+
+/**
+ * @brief Tell the form of the URI and split its hier-part, once the sweep has
+ * found where the query and the fragment start
+ * 
+ * @note Only the scheme and the authority, at the front of an absolute-form
+ * target, are looked at here. The rest of the URI was delimited by the sweep.
+ */
+static inline void __lhttp_request_split_uri(lhttp_request_t *request)
 {
-	// Mark the boundaries of the request line
-	request->__request_line_start = request->__buf;
-	request->__request_line_end   = strstr(request->__buf, "\r\n");
+	const lhttp_uri_slice_t *parts = request->__uri_parts;
+	const char *start = request->__uri_start;
+	const char *end   = request->__uri_end;
+	const char *p;
 
-	// Invalid request line
-	if (request->__request_line_end == NULL)
+	request->uri     = start;
+	request->uri_len = end - start;
+
+	// The fragment ends the URI and the query ends before it, each preceded
+	// by its delimiter
+	if (parts[LHTTP_URI_FRAGMENT].offset != 0)
 	{
-		return LHTTP_REQUEST_ERROR;
+		p = request->__data + parts[LHTTP_URI_FRAGMENT].offset;
+		__lhttp_request_uri_slice(request, LHTTP_URI_FRAGMENT, p, end);
+		end = p - 1;
+	}
+
+	if (parts[LHTTP_URI_QUERY].offset != 0)
+	{
+		p = request->__data + parts[LHTTP_URI_QUERY].offset;
+		__lhttp_request_uri_slice(request, LHTTP_URI_QUERY, p, end);
+		end = p - 1;
 	}
 
-	// Mark the boundaries of the method
-	request->__method_start = request->__request_line_start;
-	request->__method_end   = strstr(request->__method_start, " ");
+	// RFC 9112 3.2.3: CONNECT names a host and a port, nothing else
+	if (request->method == LHTTP_METHOD_CONNECT)
+	{
+		if (end == request->__uri_end &&
+		    memchr(start, '/', end - start) == NULL)
+		{
+			__lhttp_request_uri_slice(request, LHTTP_URI_AUTHORITY, start, end);
+			request->uri_form = LHTTP_URI_FORM_AUTHORITY;
+		}
 
-	// Check if the length of the method is valid
-	CHECK_VALID_STRING(request->__method_start, request->__method_end);
+		return;
+	}
 
-	// Allow loose spacing between method and URI
-	request->__uri_start = request->__method_end + 1;
-	for (; *request->__uri_start == ' '; request->__uri_start++)
-		;
+	if (*start == '/')
+	{
+		__lhttp_request_uri_slice(request, LHTTP_URI_PATH, start, end);
+		request->uri_form = LHTTP_URI_FORM_ORIGIN;
+		return;
+	}
 
-	// Mark the boundaries of the URI
-	request->__uri_end = strstr(request->__uri_start, " ");
+	if (*start == '*' && request->uri_len == 1)
+	{
+		request->uri_form = LHTTP_URI_FORM_ASTERISK;
+		return;
+	}
+
+	// Anything else must be an absolute-URI, which starts with a scheme
+	if (!(__lhttp_char_class[(unsigned char)*start] & LHTTP_CHAR_ALPHA))
+		return;
 
-	// Check if the length of the URI is valid
-	CHECK_VALID_STRING(request->__uri_start, request->__uri_end);
+	p = __lhttp_request_span(start, end, LHTTP_CHAR_SCHEME);
 
-	// Allow loose spacing between URI and version
-	request->__version_start = request->__uri_end + 1;
-	for (; *request->__version_start == ' '; request->__version_start++)
-		;
+	if (p == end || *p != ':')
+		return;
+
+	__lhttp_request_uri_slice(request, LHTTP_URI_SCHEME, start, p);
+	p++;
+
+	// "//" introduces an authority, which runs up to the path
+	if (end - p >= 2 && p[0] == '/' && p[1] == '/')
+	{
+		start = p + 2;
+		p     = memchr(start, '/', end - start);
+		p     = p != NULL ? p : end;
+		__lhttp_request_uri_slice(request, LHTTP_URI_AUTHORITY, start, p);
+	}
+
+	__lhttp_request_uri_slice(request, LHTTP_URI_PATH, p, end);
+	request->uri_form = LHTTP_URI_FORM_ABSOLUTE;
+}
+
+static inline int __lhttp_request_parse_request_line(lhttp_request_t *request)
+{
+	const char *p   = request->__data + request->__pos;
+	const char *end = request->__data + request->__data_len;
+	const char *delimiters;
+
+	// Every boundary of the request line is either a SP or the CR of the
+	// terminating CRLF, so each state continues the forward sweep over
+	// " \r\n" from where the previous one stopped.
+	switch (request->__state)
+	{
+	case LHTTP_REQUEST_STATE_START:
+		request->__request_line_start = p;
+		request->__method_start       = p;
+		request->__state              = LHTTP_REQUEST_STATE_METHOD;
+		// fall through
+
+	case LHTTP_REQUEST_STATE_METHOD:
+		// Mark the end of the method
+		p = __lhttp_scan_find(p, end, " \r\n");
+
+		if (p == end)
+		{
+			return __lhttp_request_need_more(request, p);
+		}
+
+		if (*p != ' ')
+		{
+			return __lhttp_request_fail(request, LHTTP_REQUEST_ERROR_METHOD);
+		}
+
+		request->__method_end = p;
+
+		// Check if the length of the method is valid
+		CHECK_VALID_STRING(
+		    request,
+		    request->__method_start,
+		    request->__method_end,
+		    LHTTP_REQUEST_ERROR_METHOD
+		);
+
+		// Decode the method while its bytes are still hot in the cache
+		request->method = __lhttp_method_decode(
+		    request->__method_start,
+		    request->__method_end - request->__method_start
+		);
+
+		if (request->method == LHTTP_METHOD_INVALID)
+		{
+			return __lhttp_request_fail(request, LHTTP_REQUEST_ERROR_METHOD);
+		}
+
+		request->__state = LHTTP_REQUEST_STATE_SPACES_BEFORE_URI;
+		// fall through
+
+	case LHTTP_REQUEST_STATE_SPACES_BEFORE_URI:
+		// Allow loose spacing between method and URI
+		for (; p < end && *p == ' '; p++)
+			;
+
+		if (p == end)
+		{
+			return __lhttp_request_need_more(request, p);
+		}
+
+		request->__uri_start = p;
+		request->__state     = LHTTP_REQUEST_STATE_URI;
+		// fall through
+
+	case LHTTP_REQUEST_STATE_URI:
+		// Mark the end of the URI, and the start of the query and of the
+		// fragment on the way
+		for (;;)
+		{
+			delimiters = __lhttp_request_uri_delimiters(request);
+			p          = __lhttp_scan_find(p, end, delimiters);
+
+			if (p == end)
+			{
+				return __lhttp_request_need_more(request, p);
+			}
+
+			if (*p == '?')
+			{
+				request->__uri_parts[LHTTP_URI_QUERY].offset =
+				    p + 1 - request->__data;
+			}
+			else if (*p == '#')
+			{
+				request->__uri_parts[LHTTP_URI_FRAGMENT].offset =
+				    p + 1 - request->__data;
+			}
+			else
+			{
+				break;
+			}
+
+			p++;
+		}
+
+		if (*p != ' ')
+		{
+			return __lhttp_request_fail(request, LHTTP_REQUEST_ERROR_URI);
+		}
+
+		request->__uri_end = p;
+		__lhttp_request_split_uri(request);
+
+		request->__state = LHTTP_REQUEST_STATE_SPACES_BEFORE_VERSION;
+		// fall through
+
+	case LHTTP_REQUEST_STATE_SPACES_BEFORE_VERSION:
+		// Allow loose spacing between URI and version
+		for (; p < end && *p == ' '; p++)
+			;
+
+		if (p == end)
+		{
+			return __lhttp_request_need_more(request, p);
+		}
+
+		request->__version_start = p;
+		request->__state         = LHTTP_REQUEST_STATE_VERSION;
+		// fall through
+
+	case LHTTP_REQUEST_STATE_VERSION:
+		// Mark the end of the version, which ends the request line
+		p = __lhttp_scan_find(p, end, " \r\n");
 
-	// Mark the boundaries of the version
-	request->__version_end = strstr(request->__version_start, "\r\n");
+		if (p == end)
+		{
+			return __lhttp_request_need_more(request, p);
+		}
 
-	// Check if the length of the version is valid
-	CHECK_VALID_STRING(request->__version_start, request->__version_end);
+		if (*p != '\r')
+		{
+			return __lhttp_request_fail(request, LHTTP_REQUEST_ERROR_VERSION);
+		}
+
+		request->__version_end      = p;
+		request->__request_line_end = p;
+
+		// Check if the version is a valid HTTP-version and decode it
+		if (__lhttp_version_decode(
+		        request->__version_start,
+		        request->__version_end - request->__version_start,
+		        &request->version
+		    ) != 0)
+		{
+			return __lhttp_request_fail(request, LHTTP_REQUEST_ERROR_VERSION);
+		}
+
+		p++;
+		request->__state = LHTTP_REQUEST_STATE_REQUEST_LINE_LF;
+		// fall through
+
+	case LHTTP_REQUEST_STATE_REQUEST_LINE_LF:
+		if (p == end)
+		{
+			return __lhttp_request_need_more(request, p);
+		}
+
+		if (*p != '\n')
+		{
+			return __lhttp_request_fail(request, LHTTP_REQUEST_REQUEST_LINE);
+		}
+
+		p++;
+		request->__headers_start = p;
+		request->__state         = LHTTP_REQUEST_STATE_HEADER_LINE_START;
+		request->__pos           = p - request->__data;
+		break;
+
+	default:
+		// The request line was completed by an earlier call
+		break;
+	}
 
 	return 0;
 }
 
-void lhttp_request_free(lhttp_request_t *request)
+/**
+ * @brief Check whether `header` has the same value as the first occurrence of
+ * the same well-known field
+ */
+static inline bool
+__lhttp_request_same_value(lhttp_request_t *request, lhttp_header_t *header)
 {
-	if (request == NULL)
-		return;
+	uint16_t first = request->__known_headers[header->id] - 1;
+	const lhttp_header_t *known = &request->__header_table[first];
 
-	if (request->__buf != NULL)
+	return known->value_length == header->value_length &&
+	       memcmp(
+	           request->__data + known->value_offset,
+	           request->__data + header->value_offset,
+	           header->value_length
+	       ) == 0;
+}
+
+/**
+ * @brief Block of the header section classified by `__lhttp_scan_classify`,
+ * shared by the header lines it spans
+ */
+struct __lhttp_request_block_s
+{
+	const char *base;               // first byte of the block
+	const char *limit;              // one past the last byte of the block
+	__lhttp_scan_classes_t classes; // masks of the block
+};
+
+/**
+ * @brief Find the first byte from `p` that ends a field name (`name`) or a
+ * field value (`!name`), classifying the header section one block at a time
+ * 
+ * @return A pointer to a colon (names only), a CR, a LF or an illegal byte
+ * (values only), or `end` if there is none
+ * 
+ * @note Every byte is classified once per call to `lhttp_request_parse`, for
+ * names and values alike: the masks of a block are reused by the following
+ * lines until `p` leaves it.
+ */
+static inline const char *__lhttp_request_next(
+    struct __lhttp_request_block_s *block,
+    const char *p,
+    const char *end,
+    bool name
+)
+{
+	uint64_t bits;
+
+	for (;;)
 	{
-		free(request->__buf);
-		request->__buf     = NULL;
-		request->__buf_len = 0;
+		if (p >= block->limit)
+		{
+			if (p == end)
+			{
+				return end;
+			}
+
+			block->base  = p;
+			block->limit = p + (end - p < LHTTP_SCAN_BLOCK ? end - p
+			                                               : LHTTP_SCAN_BLOCK);
+			__lhttp_scan_classify(p, block->limit - p, &block->classes);
+		}
+
+		bits = block->classes.cr | block->classes.lf |
+		       (name ? block->classes.colon : block->classes.illegal);
+		bits &= ~0ULL << (p - block->base);
+
+		if (bits != 0)
+		{
+			return block->base + __builtin_ctzll(bits);
+		}
+
+		p = block->limit;
 	}
-	return;
 }
 
 static inline int __lhttp_request_parse_headers(lhttp_request_t *request)
 {
-	return 0;
+	const char *p   = request->__data + request->__pos;
+	const char *end = request->__data + request->__data_len;
+	struct __lhttp_request_block_s block = {.base = p, .limit = p};
+	lhttp_header_t *header;
+	const char *name;
+	const char *value_end;
+
+	for (;;)
+	{
+		// Slice of the header line being parsed. It only becomes part of the
+		// table once the line is complete and `__header_count` is bumped.
+		header = &request->__header_table[request->__header_count];
+
+		switch (request->__state)
+		{
+		case LHTTP_REQUEST_STATE_HEADER_LINE_START:
+			if (p == end)
+			{
+				return __lhttp_request_need_more(request, p);
+			}
+
+			// An empty line ends the header section
+			if (*p == '\r')
+			{
+				request->__headers_end = p++;
+				request->__state       = LHTTP_REQUEST_STATE_HEADERS_END_LF;
+				break;
+			}
+
+			// Obsolete line folding is rejected, as RFC 9112 allows
+			if (*p == ' ' || *p == '\t')
+			{
+				return __lhttp_request_fail(
+				    request,
+				    LHTTP_REQUEST_ERROR_HEADERS
+				);
+			}
+
+			if (request->__header_count == LHTTP_REQUEST_MAX_HEADERS)
+			{
+				return __lhttp_request_fail(
+				    request,
+				    LHTTP_REQUEST_ERROR_TOO_LARGE | LHTTP_REQUEST_ERROR_HEADERS
+				);
+			}
+
+			header->name_offset = p - request->__data;
+			request->__state    = LHTTP_REQUEST_STATE_HEADER_NAME;
+			// fall through
+
+		case LHTTP_REQUEST_STATE_HEADER_NAME:
+			p = __lhttp_request_next(&block, p, end, true);
+
+			if (p == end)
+			{
+				return __lhttp_request_need_more(request, p);
+			}
+
+			name = request->__data + header->name_offset;
+
+			// The name must be a non-empty token right before the colon
+			if (*p != ':' || p == name || p[-1] == ' ' || p[-1] == '\t')
+			{
+				return __lhttp_request_fail(
+				    request,
+				    LHTTP_REQUEST_ERROR_HEADERS
+				);
+			}
+
+			if (p - name > UINT16_MAX)
+			{
+				return __lhttp_request_fail(
+				    request,
+				    LHTTP_REQUEST_ERROR_TOO_LARGE | LHTTP_REQUEST_ERROR_HEADERS
+				);
+			}
+
+			// Match the name against the well-known fields right away
+			header->name_length = p - name;
+			header->id          = lhttp_header_id(name, header->name_length);
+
+			p++;
+			request->__state = LHTTP_REQUEST_STATE_SPACES_BEFORE_VALUE;
+			// fall through
+
+		case LHTTP_REQUEST_STATE_SPACES_BEFORE_VALUE:
+			// Leading OWS is not part of the value
+			for (; p < end && (*p == ' ' || *p == '\t'); p++)
+				;
+
+			if (p == end)
+			{
+				return __lhttp_request_need_more(request, p);
+			}
+
+			header->value_offset = p - request->__data;
+			request->__state     = LHTTP_REQUEST_STATE_HEADER_VALUE;
+			// fall through
+
+		case LHTTP_REQUEST_STATE_HEADER_VALUE:
+			p = __lhttp_request_next(&block, p, end, false);
+
+			if (p == end)
+			{
+				return __lhttp_request_need_more(request, p);
+			}
+
+			// A CTL does not end the value: the first one is remembered for
+			// `lhttp_request_validate`, which then never scans values
+			if (*p != '\r' && *p != '\n')
+			{
+				if (request->__header_illegal == 0)
+				{
+					request->__header_illegal = p - request->__data + 1;
+				}
+
+				p++;
+				break;
+			}
+
+			// Header lines must end with CRLF, not a bare LF
+			if (*p != '\r')
+			{
+				return __lhttp_request_fail(
+				    request,
+				    LHTTP_REQUEST_ERROR_HEADERS
+				);
+			}
+
+			// Trailing OWS is not part of the value either. Only the
+			// whitespace itself is looked at again, never the value.
+			value_end = p;
+			while (value_end > request->__data + header->value_offset &&
+			       (value_end[-1] == ' ' || value_end[-1] == '\t'))
+			{
+				value_end--;
+			}
+
+			header->value_length =
+			    (value_end - request->__data) - header->value_offset;
+
+			p++;
+			request->__state = LHTTP_REQUEST_STATE_HEADER_LINE_LF;
+			// fall through
+
+		case LHTTP_REQUEST_STATE_HEADER_LINE_LF:
+			if (p == end)
+			{
+				return __lhttp_request_need_more(request, p);
+			}
+
+			if (*p != '\n')
+			{
+				return __lhttp_request_fail(
+				    request,
+				    LHTTP_REQUEST_ERROR_HEADERS
+				);
+			}
+
+			p++;
+
+			// Only the first occurrence of a well-known field gets the slot
+			if (header->id != LHTTP_HEADER_UNKNOWN &&
+			    request->__known_headers[header->id] == 0)
+			{
+				request->__known_headers[header->id] =
+				    request->__header_count + 1;
+			}
+			else if (header->id == LHTTP_HEADER_CONTENT_LENGTH &&
+			         !__lhttp_request_same_value(request, header))
+			{
+				// Conflicting lengths make the framing ambiguous
+				return __lhttp_request_fail(
+				    request,
+				    LHTTP_REQUEST_ERROR_HEADERS
+				);
+			}
+
+			request->__header_count++;
+			request->__state = LHTTP_REQUEST_STATE_HEADER_LINE_START;
+			break;
+
+		case LHTTP_REQUEST_STATE_HEADERS_END_LF:
+			if (p == end)
+			{
+				return __lhttp_request_need_more(request, p);
+			}
+
+			if (*p != '\n')
+			{
+				return __lhttp_request_fail(
+				    request,
+				    LHTTP_REQUEST_ERROR_HEADERS
+				);
+			}
+
+			p++;
+			request->__body_start = p;
+			request->__body_end   = p;
+			request->__state      = LHTTP_REQUEST_STATE_BODY_START;
+			request->__pos        = p - request->__data;
+			return 0;
+
+		default:
+			// The header section was completed by an earlier call
+			return 0;
+		}
+	}
+}
+
+/**
+ * @brief Value of the hexadecimal digit `c`, or -1 if it is not one
+ */
+static inline int __lhttp_hex_value(unsigned char c)
+{
+	return __lhttp_hex_digit[c] != 0xFF ? __lhttp_hex_digit[c] : -1;
+}
+
+/**
+ * @brief Check whether the last transfer coding of the request is chunked
+ * 
+ * @param request An existing HTTP request object
+ * @return true if the final coding of the last Transfer-Encoding field is
+ * "chunked"
+ */
+static inline bool __lhttp_request_is_chunked(lhttp_request_t *request)
+{
+	const lhttp_header_t *te = NULL;
+	const char *coding, *value;
+	size_t i;
+
+	// Transfer-Encoding is rare in requests, and only the last one matters
+	i = request->__known_headers[LHTTP_HEADER_TRANSFER_ENCODING] - 1;
+	for (; i < request->__header_count; i++)
+	{
+		if (request->__header_table[i].id == LHTTP_HEADER_TRANSFER_ENCODING)
+			te = &request->__header_table[i];
+	}
+
+	value  = request->__data + te->value_offset;
+	coding = value + te->value_length;
+
+	// The final coding starts after the last comma and its OWS
+	while (coding > value && coding[-1] != ',')
+		coding--;
+
+	while (*coding == ' ' || *coding == '\t')
+		coding++;
+
+	if (value + te->value_length - coding != 7)
+		return false;
+
+	for (i = 0; i < 7; i++)
+	{
+		if ((coding[i] | 0x20) != "chunked"[i])
+			return false;
+	}
+
+	return true;
+}
+
+/**
+ * @brief Pick the framing of the body from the header section
+ * 
+ * @param request An existing HTTP request object
+ * @return 0 on success, -1 on failure
+ */
+static inline int __lhttp_request_frame_body(lhttp_request_t *request)
+{
+	const char *value;
+	size_t value_len, length, i;
+	bool has_te, has_cl;
+
+	has_te = request->__known_headers[LHTTP_HEADER_TRANSFER_ENCODING] != 0;
+	has_cl = request->__known_headers[LHTTP_HEADER_CONTENT_LENGTH] != 0;
+
+	if (has_te)
+	{
+		// A request with both is a classic smuggling vector, and a request
+		// whose last coding is not chunked has no length at all. RFC 9112
+		// has servers reject both.
+		if (has_cl || !__lhttp_request_is_chunked(request))
+		{
+			return __lhttp_request_fail(request, LHTTP_REQUEST_ERROR_BODY);
+		}
+
+		request->__body_remaining = 0;
+		request->__state          = LHTTP_REQUEST_STATE_CHUNK_SIZE_START;
+		return 0;
+	}
+
+	if (!has_cl)
+	{
+		// No body at all
+		request->__state = LHTTP_REQUEST_STATE_DONE;
+		return 0;
+	}
+
+	lhttp_request_header_get(
+	    request,
+	    LHTTP_HEADER_CONTENT_LENGTH,
+	    &value,
+	    &value_len
+	);
+
+	if (value_len == 0)
+	{
+		return __lhttp_request_fail(request, LHTTP_REQUEST_ERROR_BODY);
+	}
+
+	for (length = 0, i = 0; i < value_len; i++)
+	{
+		if (value[i] < '0' || value[i] > '9' || length > SIZE_MAX / 10 - 1)
+		{
+			return __lhttp_request_fail(request, LHTTP_REQUEST_ERROR_BODY);
+		}
+
+		length = length * 10 + (value[i] - '0');
+	}
+
+	// Fail right away rather than after buffering what fits
+	if (length > request->__buf_len - request->__pos)
+	{
+		return __lhttp_request_fail(
+		    request,
+		    LHTTP_REQUEST_ERROR_TOO_LARGE | LHTTP_REQUEST_ERROR_BODY
+		);
+	}
+
+	request->__body_remaining = length;
+	request->__state          = LHTTP_REQUEST_STATE_BODY_IDENTITY;
+
+	return 0;
+}
+
+/**
+ * @brief Skip up to `request->__body_remaining` bytes of body data
+ * 
+ * @return The first byte after the skipped data
+ */
+static inline const char *__lhttp_request_skip_data(
+    lhttp_request_t *request,
+    const char *p,
+    const char *end
+)
+{
+	size_t avail = end - p;
+
+	if (avail > request->__body_remaining)
+	{
+		avail = request->__body_remaining;
+	}
+
+	request->__body_remaining -= avail;
+
+	return p + avail;
+}
+
+static inline int __lhttp_request_parse_body(lhttp_request_t *request)
+{
+	const char *p   = request->__data + request->__pos;
+	const char *end = request->__data + request->__data_len;
+	int digit;
+
+	for (;;)
+	{
+		switch (request->__state)
+		{
+		case LHTTP_REQUEST_STATE_BODY_START:
+			if (__lhttp_request_frame_body(request) != 0)
+			{
+				return LHTTP_REQUEST_ERROR;
+			}
+			break;
+
+		case LHTTP_REQUEST_STATE_BODY_IDENTITY:
+			// The body is not looked at, only counted
+			p                   = __lhttp_request_skip_data(request, p, end);
+			request->__body_end = p;
+
+			if (request->__body_remaining > 0)
+			{
+				return __lhttp_request_need_more(request, p);
+			}
+
+			request->__state = LHTTP_REQUEST_STATE_DONE;
+			break;
+
+		case LHTTP_REQUEST_STATE_CHUNK_SIZE_START:
+			if (p == end)
+			{
+				return __lhttp_request_need_more(request, p);
+			}
+
+			// The chunk size needs at least one digit
+			if (__lhttp_hex_value(*p) < 0)
+			{
+				return __lhttp_request_fail(request, LHTTP_REQUEST_ERROR_BODY);
+			}
+
+			request->__state = LHTTP_REQUEST_STATE_CHUNK_SIZE;
+			// fall through
+
+		case LHTTP_REQUEST_STATE_CHUNK_SIZE:
+			for (; p < end && (digit = __lhttp_hex_value(*p)) >= 0; p++)
+			{
+				if (request->__body_remaining > (SIZE_MAX >> 4))
+				{
+					return __lhttp_request_fail(
+					    request,
+					    LHTTP_REQUEST_ERROR_TOO_LARGE | LHTTP_REQUEST_ERROR_BODY
+					);
+				}
+
+				request->__body_remaining =
+				    (request->__body_remaining << 4) | digit;
+			}
+
+			if (p == end)
+			{
+				return __lhttp_request_need_more(request, p);
+			}
+
+			if (*p != ';' && *p != '\r' && *p != ' ' && *p != '\t')
+			{
+				return __lhttp_request_fail(request, LHTTP_REQUEST_ERROR_BODY);
+			}
+
+			request->__state = LHTTP_REQUEST_STATE_CHUNK_EXTENSION;
+			// fall through
+
+		case LHTTP_REQUEST_STATE_CHUNK_EXTENSION:
+			// Chunk extensions are not interpreted, only skipped
+			p = __lhttp_scan_find(p, end, "\r\n");
+
+			if (p == end)
+			{
+				return __lhttp_request_need_more(request, p);
+			}
+
+			if (*p != '\r')
+			{
+				return __lhttp_request_fail(request, LHTTP_REQUEST_ERROR_BODY);
+			}
+
+			p++;
+			request->__state = LHTTP_REQUEST_STATE_CHUNK_SIZE_LF;
+			// fall through
+
+		case LHTTP_REQUEST_STATE_CHUNK_SIZE_LF:
+			if (p == end)
+			{
+				return __lhttp_request_need_more(request, p);
+			}
+
+			if (*p != '\n')
+			{
+				return __lhttp_request_fail(request, LHTTP_REQUEST_ERROR_BODY);
+			}
+
+			p++;
+
+			// The last chunk is empty and followed by the trailer section
+			request->__state = request->__body_remaining == 0
+			                       ? LHTTP_REQUEST_STATE_TRAILER_LINE_START
+			                       : LHTTP_REQUEST_STATE_CHUNK_DATA;
+			break;
+
+		case LHTTP_REQUEST_STATE_CHUNK_DATA:
+			p = __lhttp_request_skip_data(request, p, end);
+
+			if (request->__body_remaining > 0)
+			{
+				return __lhttp_request_need_more(request, p);
+			}
+
+			request->__state = LHTTP_REQUEST_STATE_CHUNK_DATA_CR;
+			// fall through
+
+		case LHTTP_REQUEST_STATE_CHUNK_DATA_CR:
+		case LHTTP_REQUEST_STATE_CHUNK_DATA_LF:
+		case LHTTP_REQUEST_STATE_TRAILER_LINE_LF:
+		case LHTTP_REQUEST_STATE_TRAILER_END_LF:
+			if (p == end)
+			{
+				return __lhttp_request_need_more(request, p);
+			}
+
+			if (*p != (request->__state == LHTTP_REQUEST_STATE_CHUNK_DATA_CR
+			               ? '\r'
+			               : '\n'))
+			{
+				return __lhttp_request_fail(request, LHTTP_REQUEST_ERROR_BODY);
+			}
+
+			p++;
+
+			if (request->__state == LHTTP_REQUEST_STATE_CHUNK_DATA_CR)
+			{
+				request->__state = LHTTP_REQUEST_STATE_CHUNK_DATA_LF;
+			}
+			else if (request->__state == LHTTP_REQUEST_STATE_CHUNK_DATA_LF)
+			{
+				request->__state = LHTTP_REQUEST_STATE_CHUNK_SIZE_START;
+			}
+			else if (request->__state == LHTTP_REQUEST_STATE_TRAILER_LINE_LF)
+			{
+				request->__state = LHTTP_REQUEST_STATE_TRAILER_LINE_START;
+			}
+			else
+			{
+				// The body markers span the whole chunked encoding
+				request->__body_end = p;
+				request->__state    = LHTTP_REQUEST_STATE_DONE;
+			}
+			break;
+
+		case LHTTP_REQUEST_STATE_TRAILER_LINE_START:
+			if (p == end)
+			{
+				return __lhttp_request_need_more(request, p);
+			}
+
+			if (*p == '\r')
+			{
+				p++;
+				request->__state = LHTTP_REQUEST_STATE_TRAILER_END_LF;
+				break;
+			}
+
+			request->__state = LHTTP_REQUEST_STATE_TRAILER_LINE;
+			// fall through
+
+		case LHTTP_REQUEST_STATE_TRAILER_LINE:
+			// Trailer fields are skipped, they are not indexed
+			p = __lhttp_scan_find(p, end, "\r\n");
+
+			if (p == end)
+			{
+				return __lhttp_request_need_more(request, p);
+			}
+
+			if (*p != '\r')
+			{
+				return __lhttp_request_fail(request, LHTTP_REQUEST_ERROR_BODY);
+			}
+
+			p++;
+			request->__state = LHTTP_REQUEST_STATE_TRAILER_LINE_LF;
+			break;
+
+		case LHTTP_REQUEST_STATE_DONE:
+			request->__pos = p - request->__data;
+			return 0;
+
+		default:
+			return __lhttp_request_fail(request, LHTTP_REQUEST_ERROR_UNKNOWN);
+		}
+	}
+}
+
+size_t lhttp_request_header_count(const lhttp_request_t *request)
+{
+	return request->__header_count;
+}
+
+int lhttp_request_header_at(
+    const lhttp_request_t *request,
+    size_t index,
+    const char **name,
+    size_t *name_len,
+    const char **value,
+    size_t *value_len
+)
+{
+	const lhttp_header_t *header;
+
+	if (index >= request->__header_count)
+	{
+		return LHTTP_REQUEST_ERROR;
+	}
+
+	header = &request->__header_table[index];
+
+	*name      = request->__data + header->name_offset;
+	*name_len  = header->name_length;
+	*value     = request->__data + header->value_offset;
+	*value_len = header->value_length;
+
+	return LHTTP_REQUEST_OK;
+}
+
+int lhttp_request_header_get(
+    const lhttp_request_t *request,
+    lhttp_header_id_t id,
+    const char **value,
+    size_t *value_len
+)
+{
+	const lhttp_header_t *header;
+
+	if ((unsigned int)id >= LHTTP_HEADER_UNKNOWN ||
+	    request->__known_headers[id] == 0)
+	{
+		return LHTTP_REQUEST_ERROR;
+	}
+
+	header = &request->__header_table[request->__known_headers[id] - 1];
+
+	*value     = request->__data + header->value_offset;
+	*value_len = header->value_length;
+
+	return LHTTP_REQUEST_OK;
+}
+
+int lhttp_request_uri_part(
+    const lhttp_request_t *request,
+    lhttp_uri_part_t part,
+    const char **value,
+    size_t *value_len
+)
+{
+	const lhttp_uri_slice_t *slice;
+
+	if ((unsigned int)part >= LHTTP_URI_PART_COUNT ||
+	    request->__uri_parts[part].offset == 0)
+	{
+		return LHTTP_REQUEST_ERROR;
+	}
+
+	slice = &request->__uri_parts[part];
+
+	*value     = request->__data + slice->offset;
+	*value_len = slice->length;
+
+	return LHTTP_REQUEST_OK;
+}
+
+int lhttp_request_uri_decode(
+    lhttp_request_t *request,
+    lhttp_uri_part_t part,
+    lhttp_uri_decode_mode_t mode
+)
+{
+	lhttp_uri_slice_t *slice;
+	size_t len;
+
+	if (request == NULL || request->__borrowed ||
+	    request->status != LHTTP_REQUEST_PARSING_DONE ||
+	    (unsigned int)part >= LHTTP_URI_PART_COUNT ||
+	    request->__uri_parts[part].offset == 0)
+	{
+		return LHTTP_REQUEST_ERROR;
+	}
+
+	// Only the path mode refuses encoded slashes, which must not appear in
+	// a path that may have been normalized already
+	if (part == LHTTP_URI_PATH && mode != LHTTP_URI_DECODE_PATH)
+	{
+		return LHTTP_REQUEST_ERROR;
+	}
+
+	if (request->__uri_decoded & (1u << part))
+	{
+		return LHTTP_REQUEST_OK;
+	}
+
+	slice = &request->__uri_parts[part];
+
+	// An owned message is in `__buf`, which the request may write to
+	if (lhttp_uri_decode(
+	        request->__buf + slice->offset,
+	        slice->length,
+	        mode,
+	        &len
+	    ) != 0)
+	{
+		return LHTTP_REQUEST_ERROR;
+	}
+
+	slice->length           = len;
+	request->__uri_decoded |= 1u << part;
+
+	return LHTTP_REQUEST_OK;
+}
+
+int lhttp_request_uri_normalize(lhttp_request_t *request)
+{
+	lhttp_uri_slice_t *slice;
+	size_t len;
+
+	if (request == NULL || request->__borrowed ||
+	    request->status != LHTTP_REQUEST_PARSING_DONE ||
+	    request->__uri_parts[LHTTP_URI_PATH].offset == 0)
+	{
+		return LHTTP_REQUEST_ERROR;
+	}
+
+	// A decoded "%252e" reads as "%2e", which would be taken for a dot
+	if (request->__uri_decoded & (1u << LHTTP_URI_PATH))
+	{
+		return LHTTP_REQUEST_ERROR;
+	}
+
+	slice = &request->__uri_parts[LHTTP_URI_PATH];
+
+	if (lhttp_uri_normalize_path(
+	        request->__buf + slice->offset,
+	        slice->length,
+	        &len
+	    ) != 0)
+	{
+		return LHTTP_REQUEST_ERROR;
+	}
+
+	slice->length = len;
+
+	return LHTTP_REQUEST_OK;
+}
+
+int lhttp_request_header_list(
+    const lhttp_request_t *request,
+    lhttp_list_t *list
+)
+{
+	lhttp_list_field_t fields[LHTTP_REQUEST_MAX_HEADERS];
+	const lhttp_header_t *header;
+	size_t i;
+
+	for (i = 0; i < request->__header_count; i++)
+	{
+		header = &request->__header_table[i];
+
+		fields[i].name      = request->__data + header->name_offset;
+		fields[i].name_len  = header->name_length;
+		fields[i].value     = request->__data + header->value_offset;
+		fields[i].value_len = header->value_length;
+	}
+
+	if (lhttp_list_add_all(list, fields, request->__header_count) !=
+	    LHTTP_LIST_OK)
+	{
+		return LHTTP_REQUEST_ERROR;
+	}
+
+	return LHTTP_REQUEST_OK;
+}
+
+/* Fold an ASCII letter to lowercase. Other bytes of a field name are left
+ * alone or mapped to bytes that no well-known name contains (CR, the only
+ * byte folding to '-', cannot be part of a name). */
+#define LHTTP_FOLD(c) ((unsigned char)((c) | 0x20))
+
+lhttp_header_id_t lhttp_header_id(const char *name, size_t len)
+{
+	const char *known;
+	unsigned int h;
+	size_t i;
+	int id;
+
+	if (len == 0)
+	{
+		return LHTTP_HEADER_UNKNOWN;
+	}
+
+	h = LHTTP_HEADER_HASH_A * LHTTP_FOLD(name[0]) +
+	    LHTTP_HEADER_HASH_B * LHTTP_FOLD(name[len / 2]) +
+	    LHTTP_HEADER_HASH_C * LHTTP_FOLD(name[len - 1]) + len;
+
+	// A single probe: the only known name that can match is in this slot
+	id = __lhttp_header_slots[h & (LHTTP_HEADER_HASH_SIZE - 1)];
+
+	if (id == LHTTP_HEADER_UNKNOWN || __lhttp_header_lengths[id] != len)
+	{
+		return LHTTP_HEADER_UNKNOWN;
+	}
+
+	known = __lhttp_header_names[id];
+	for (i = 0; i < len; i++)
+	{
+		if (LHTTP_FOLD(name[i]) != (unsigned char)known[i])
+			return LHTTP_HEADER_UNKNOWN;
+	}
+
+	return id;
+}
+
+/**
+ * @brief Check the request-target `[p, end)`: RFC 3986 bytes only, and a '%'
+ * always followed by two hexadecimal digits
+ * 
+ * @return true if the target is well-formed
+ */
+static inline bool __lhttp_request_check_uri(const char *p, const char *end)
+{
+	for (;;)
+	{
+		p = __lhttp_request_span(p, end, LHTTP_CHAR_URI);
+
+		if (p == end)
+			return true;
+
+		// The span stops at a '%' or at a byte that is never allowed
+		if (*p != '%' || end - p < 3 ||
+		    !(__lhttp_char_class[(unsigned char)p[1]] & LHTTP_CHAR_HEX) ||
+		    !(__lhttp_char_class[(unsigned char)p[2]] & LHTTP_CHAR_HEX))
+		{
+			return false;
+		}
+
+		p += 3;
+	}
+}
+
+/**
+ * @brief Check every part of a parsed request, in message order
+ * 
+ * @return The HTTP status answering the request, 200 if it is valid
+ */
+static int __lhttp_request_check(const lhttp_request_t *request)
+{
+	const lhttp_header_t *header;
+	const char *name;
+	size_t i, hosts = 0;
+
+	if (__lhttp_request_span(
+	        request->__method_start,
+	        request->__method_end,
+	        LHTTP_CHAR_TCHAR
+	    ) != request->__method_end)
+	{
+		return 400;
+	}
+
+	// The length is known from the markers, before any byte is looked at
+	if (request->__uri_end - request->__uri_start >
+	    LHTTP_REQUEST_MAX_URI_LENGTH)
+	{
+		return 414;
+	}
+
+	if (!__lhttp_request_check_uri(request->__uri_start, request->__uri_end))
+	{
+		return 400;
+	}
+
+	// RFC 9112 3.2.4: the asterisk-form only asks OPTIONS of the server
+	if (request->uri_form == LHTTP_URI_FORM_INVALID ||
+	    (request->uri_form == LHTTP_URI_FORM_ASTERISK &&
+	     request->method != LHTTP_METHOD_OPTIONS))
+	{
+		return 400;
+	}
+
+	// Malformed versions do not parse, only unsupported ones are left
+	if (request->version == LHTTP_VERSION_INVALID)
+	{
+		return 505;
+	}
+
+	for (i = 0; i < request->__header_count; i++)
+	{
+		header = &request->__header_table[i];
+		name   = request->__data + header->name_offset;
+
+		if ((size_t)header->name_length + header->value_length >
+		    LHTTP_REQUEST_MAX_FIELD_LENGTH)
+		{
+			return 431;
+		}
+
+		if (__lhttp_request_span(
+		        name,
+		        name + header->name_length,
+		        LHTTP_CHAR_TCHAR
+		    ) != name + header->name_length)
+		{
+			return 400;
+		}
+
+		// Values were classified while indexing, only the position of the
+		// first illegal byte is left to compare
+		if (request->__header_illegal > header->value_offset &&
+		    request->__header_illegal <=
+		        header->value_offset + header->value_length)
+		{
+			return 400;
+		}
+
+		hosts += header->id == LHTTP_HEADER_HOST;
+	}
+
+	// RFC 9112 3.2: exactly one Host in HTTP/1.1, at most one before
+	if (hosts > 1 || (hosts == 0 && request->version == LHTTP_VERSION_1_1))
+	{
+		return 400;
+	}
+
+	return 200;
+}
+
+/**
+ * @brief Map the error of a request that failed to parse to an HTTP status
+ * 
+ * @return The HTTP status, or -1 for errors that are not the client's
+ */
+static inline int __lhttp_request_error_status(int error)
+{
+	switch (error)
+	{
+	case LHTTP_REQUEST_ERROR_MEMORY_ALLOCATION:
+	case LHTTP_REQUEST_ERROR_UNKNOWN:
+		return -1;
+
+	case LHTTP_REQUEST_ERROR_TOO_LARGE | LHTTP_REQUEST_ERROR_URI:
+		return 414;
+
+	case LHTTP_REQUEST_ERROR_TOO_LARGE | LHTTP_REQUEST_ERROR_HEADERS:
+		return 431;
+
+	case LHTTP_REQUEST_ERROR_TOO_LARGE | LHTTP_REQUEST_ERROR_BODY:
+		return 413;
+
+	default:
+		return 400;
+	}
+}
+
+int lhttp_request_validate(lhttp_request_t *request, int *http_status)
+{
+	int status;
+
+	if (request == NULL || http_status == NULL)
+	{
+		return LHTTP_REQUEST_ERROR;
+	}
+
+	if (request->status == LHTTP_REQUEST_ERROR)
+	{
+		status = __lhttp_request_error_status(request->error);
+	}
+	else if (request->status == LHTTP_REQUEST_PARSING_DONE)
+	{
+		status = __lhttp_request_check(request);
+	}
+	else
+	{
+		status = -1;
+	}
+
+	if (status < 0)
+	{
+		return LHTTP_REQUEST_ERROR;
+	}
+
+	*http_status = status;
+
+	return LHTTP_REQUEST_OK;
+}
+
+void lhttp_request_free(lhttp_request_t *request)
+{
+	if (request == NULL)
+		return;
+
+	if (request->__buf != NULL)
+	{
+		__lhttp_free(
+		    request->__allocator,
+		    request->__buf,
+		    request->__buf_len + 1
+		);
+		request->__buf     = NULL;
+		request->__buf_len = 0;
+	}
+
+	request->__data = NULL;
+	return;
 }
@@ -0,0 +1,648 @@
+/* Copyright (c) 2024 libhttp. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "lhttp_scan.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#ifdef LHTTP_SCAN_X86
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Pick the best implementation for this CPU, then forward the call
+ */
+static const char *
+__lhttp_scan_resolve(const char *p, const char *end, const char *set, size_t n);
+
+/* Implementation used by `__lhttp_scan_find`. Resolved on the first call; the
+ * race between threads resolving at the same time is benign since they all
+ * store the same pointer. */
+__lhttp_scan_fn __lhttp_scan_impl = __lhttp_scan_resolve;
+
+static const char *__lhttp_scan_name = "scalar";
+
+/**
+ * @brief Pick the best classifier for this CPU, then forward the call
+ */
+static void __lhttp_classify_resolve(
+    const char *p,
+    size_t len,
+    __lhttp_scan_classes_t *classes
+);
+
+/* Implementation used by `__lhttp_scan_classify`, resolved like the scanner */
+__lhttp_classify_fn __lhttp_classify_impl = __lhttp_classify_resolve;
+
+/* Sets are padded to four needles by repeating the first byte, so that the
+ * common 1-4 byte sets run without an inner loop over the set. */
+#define LHTTP_SCAN_NEEDLE(set, setlen, i) ((i) < (setlen) ? (set)[i] : (set)[0])
+
+#define SWAR_ONES  0x0101010101010101ULL
+#define SWAR_HIGHS 0x8080808080808080ULL
+
+/* Mark (with the high bit) every byte of `word` equal to the splatted byte of
+ * `needle`. Only the lowest marked byte is exact, which is all we need. */
+#define SWAR_EQ(word, needle)                                                 \
+	((((word) ^ (needle)) - SWAR_ONES) & ~((word) ^ (needle)) & SWAR_HIGHS)
+
+#define SWAR_LOWS 0x7F7F7F7F7F7F7F7FULL
+
+/* Mark every byte of `word` that is zero, exactly: the low seven bits are
+ * added without carrying into the next byte. */
+#define SWAR_ZERO(word)                                                       \
+	(~((((word) & SWAR_LOWS) + SWAR_LOWS) | (word)) & SWAR_HIGHS)
+
+/* Gather the marks of the eight bytes into the low eight bits, byte i to bit
+ * i, with one multiplication that moves each mark to its own top bit. */
+#define SWAR_BITS(marks) (((marks) >> 7) * 0x0102040810204080ULL >> 56)
+
+const char *__lhttp_scan_impl_name(void)
+{
+	if (__lhttp_scan_impl == __lhttp_scan_resolve)
+	{
+		// Resolve with an empty range to get the name
+		__lhttp_scan_resolve(NULL, NULL, "", 0);
+	}
+
+	return __lhttp_scan_name;
+}
+
+/**
+ * @brief Byte-at-a-time search, used for short ranges and by every tail
+ */
+static inline const char *__lhttp_scan_bytes(
+    const char *p,
+    const char *end,
+    const char *set,
+    size_t setlen
+)
+{
+	const char c0 = LHTTP_SCAN_NEEDLE(set, setlen, 0);
+	const char c1 = LHTTP_SCAN_NEEDLE(set, setlen, 1);
+	const char c2 = LHTTP_SCAN_NEEDLE(set, setlen, 2);
+	const char c3 = LHTTP_SCAN_NEEDLE(set, setlen, 3);
+	size_t i;
+
+	for (; p < end; p++)
+	{
+		const char c = *p;
+
+		if ((c == c0) | (c == c1) | (c == c2) | (c == c3))
+			return p;
+
+		for (i = 4; i < setlen; i++)
+		{
+			if (c == set[i])
+				return p;
+		}
+	}
+
+	return end;
+}
+
+/**
+ * @brief Search a range shorter than a vector, such as the version of a
+ * request line, with two overlapping words when it holds at least eight bytes
+ */
+static inline const char *__lhttp_scan_short(
+    const char *p,
+    const char *end,
+    const char *set,
+    size_t setlen
+)
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	if (end - p >= 8 && setlen > 0 && setlen <= 4)
+	{
+		const uint64_t n0 =
+		    SWAR_ONES * (unsigned char)LHTTP_SCAN_NEEDLE(set, setlen, 0);
+		const uint64_t n1 =
+		    SWAR_ONES * (unsigned char)LHTTP_SCAN_NEEDLE(set, setlen, 1);
+		const uint64_t n2 =
+		    SWAR_ONES * (unsigned char)LHTTP_SCAN_NEEDLE(set, setlen, 2);
+		const uint64_t n3 =
+		    SWAR_ONES * (unsigned char)LHTTP_SCAN_NEEDLE(set, setlen, 3);
+		uint64_t word, hits;
+
+		memcpy(&word, p, sizeof(word));
+		hits = SWAR_EQ(word, n0) | SWAR_EQ(word, n1) | SWAR_EQ(word, n2) |
+		       SWAR_EQ(word, n3);
+		if (hits != 0)
+			return p + (__builtin_ctzll(hits) >> 3);
+
+		// The second word overlaps bytes that were already checked
+		p = end - 8;
+		memcpy(&word, p, sizeof(word));
+		hits = SWAR_EQ(word, n0) | SWAR_EQ(word, n1) | SWAR_EQ(word, n2) |
+		       SWAR_EQ(word, n3);
+
+		return hits != 0 ? p + (__builtin_ctzll(hits) >> 3) : end;
+	}
+#endif
+
+	return __lhttp_scan_bytes(p, end, set, setlen);
+}
+
+const char *__lhttp_scan_find_scalar(
+    const char *p,
+    const char *end,
+    const char *set,
+    size_t setlen
+)
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	uint64_t needles[LHTTP_SCAN_SET_MAX];
+	size_t i;
+
+	if (setlen == 0)
+		return end;
+
+	for (i = 0; i < setlen; i++)
+		needles[i] = SWAR_ONES * (unsigned char)set[i];
+
+	// Eight bytes at a time with plain integer arithmetic
+	for (; end - p >= 8; p += 8)
+	{
+		uint64_t word, hits = 0;
+
+		memcpy(&word, p, sizeof(word));
+		for (i = 0; i < setlen; i++)
+			hits |= SWAR_EQ(word, needles[i]);
+
+		if (hits != 0)
+			return p + (__builtin_ctzll(hits) >> 3);
+	}
+#endif
+
+	return __lhttp_scan_bytes(p, end, set, setlen);
+}
+
+/**
+ * @brief Classify the bytes `[i, len)` of the block at `p` one at a time, used
+ * for short blocks and by the scalar classifier
+ */
+static inline void __lhttp_scan_classify_bytes(
+    const char *p,
+    size_t i,
+    size_t len,
+    __lhttp_scan_classes_t *classes
+)
+{
+	for (; i < len; i++)
+	{
+		const unsigned char c = p[i];
+		const uint64_t bit    = 1ULL << i;
+
+		if (c == ':')
+			classes->colon |= bit;
+		else if (c == '\r')
+			classes->cr |= bit;
+		else if (c == '\n')
+			classes->lf |= bit;
+		else if ((c < 0x20 && c != '\t') || c == 0x7F)
+			classes->illegal |= bit;
+	}
+}
+
+void __lhttp_scan_classify_scalar(
+    const char *p,
+    size_t len,
+    __lhttp_scan_classes_t *classes
+)
+{
+	size_t i = 0;
+
+	classes->colon   = 0;
+	classes->cr      = 0;
+	classes->lf      = 0;
+	classes->illegal = 0;
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	// Eight bytes at a time, each class from exact per-byte compares
+	for (; len - i >= 8; i += 8)
+	{
+		uint64_t word, colon, cr, lf, ctl, illegal;
+
+		memcpy(&word, p + i, sizeof(word));
+		colon = SWAR_ZERO(word ^ SWAR_ONES * ':');
+		cr    = SWAR_ZERO(word ^ SWAR_ONES * '\r');
+		lf    = SWAR_ZERO(word ^ SWAR_ONES * '\n');
+
+		// Bytes below 0x20 carry nothing out of their low seven bits
+		ctl = ~(((word & SWAR_LOWS) + SWAR_ONES * 0x60) | word) & SWAR_HIGHS;
+
+		// Every CTL but HTAB, CR and LF, and DEL
+		illegal = (ctl & ~(cr | lf | SWAR_ZERO(word ^ SWAR_ONES * '\t'))) |
+		          SWAR_ZERO(word ^ SWAR_ONES * 0x7F);
+
+		classes->colon   |= SWAR_BITS(colon) << i;
+		classes->cr      |= SWAR_BITS(cr) << i;
+		classes->lf      |= SWAR_BITS(lf) << i;
+		classes->illegal |= SWAR_BITS(illegal) << i;
+	}
+#endif
+
+	__lhttp_scan_classify_bytes(p, i, len, classes);
+}
+
+#ifdef LHTTP_SCAN_X86
+
+int __lhttp_scan_has_sse2(void)
+{
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("sse2");
+}
+
+/**
+ * @brief Add the classes of the 16 bytes at `p + i` to `classes`
+ */
+__attribute__((target("sse2"))) static inline void
+__lhttp_scan_classify16(
+    const char *p,
+    size_t i,
+    __lhttp_scan_classes_t *classes
+)
+{
+	const __m128i x     = _mm_loadu_si128((const __m128i *)(p + i));
+	const __m128i colon = _mm_cmpeq_epi8(x, _mm_set1_epi8(':'));
+	const __m128i cr    = _mm_cmpeq_epi8(x, _mm_set1_epi8('\r'));
+	const __m128i lf    = _mm_cmpeq_epi8(x, _mm_set1_epi8('\n'));
+	const __m128i tab   = _mm_cmpeq_epi8(x, _mm_set1_epi8('\t'));
+	const __m128i del   = _mm_cmpeq_epi8(x, _mm_set1_epi8(0x7F));
+	__m128i ctl;
+
+	// Bytes up to 0x1F are the ones an unsigned minimum with 0x1F keeps
+	ctl = _mm_cmpeq_epi8(_mm_min_epu8(x, _mm_set1_epi8(0x1F)), x);
+	ctl = _mm_andnot_si128(_mm_or_si128(_mm_or_si128(cr, lf), tab), ctl);
+
+	classes->colon   |= (uint64_t)(uint16_t)_mm_movemask_epi8(colon) << i;
+	classes->cr      |= (uint64_t)(uint16_t)_mm_movemask_epi8(cr) << i;
+	classes->lf      |= (uint64_t)(uint16_t)_mm_movemask_epi8(lf) << i;
+	classes->illegal |= (uint64_t)(uint16_t)_mm_movemask_epi8(
+	                        _mm_or_si128(ctl, del)
+	                    )
+	                    << i;
+}
+
+__attribute__((target("sse2"))) void __lhttp_scan_classify_sse2(
+    const char *p,
+    size_t len,
+    __lhttp_scan_classes_t *classes
+)
+{
+	size_t i;
+
+	classes->colon   = 0;
+	classes->cr      = 0;
+	classes->lf      = 0;
+	classes->illegal = 0;
+
+	if (len < 16)
+	{
+		__lhttp_scan_classify_bytes(p, 0, len, classes);
+		return;
+	}
+
+	for (i = 0; i + 16 <= len; i += 16)
+		__lhttp_scan_classify16(p, i, classes);
+
+	// The last vector overlaps bytes that were already classified, which
+	// only sets their bits again
+	if (i < len)
+		__lhttp_scan_classify16(p, len - 16, classes);
+}
+
+/**
+ * @brief Add the classes of the 32 bytes at `p + i` to `classes`
+ */
+__attribute__((target("avx2"))) static inline void
+__lhttp_scan_classify32(
+    const char *p,
+    size_t i,
+    __lhttp_scan_classes_t *classes
+)
+{
+	const __m256i x     = _mm256_loadu_si256((const __m256i *)(p + i));
+	const __m256i colon = _mm256_cmpeq_epi8(x, _mm256_set1_epi8(':'));
+	const __m256i cr    = _mm256_cmpeq_epi8(x, _mm256_set1_epi8('\r'));
+	const __m256i lf    = _mm256_cmpeq_epi8(x, _mm256_set1_epi8('\n'));
+	const __m256i tab   = _mm256_cmpeq_epi8(x, _mm256_set1_epi8('\t'));
+	const __m256i del   = _mm256_cmpeq_epi8(x, _mm256_set1_epi8(0x7F));
+	__m256i ctl;
+
+	ctl = _mm256_cmpeq_epi8(_mm256_min_epu8(x, _mm256_set1_epi8(0x1F)), x);
+	ctl = _mm256_andnot_si256(
+	    _mm256_or_si256(_mm256_or_si256(cr, lf), tab),
+	    ctl
+	);
+
+	classes->colon   |= (uint64_t)(uint32_t)_mm256_movemask_epi8(colon) << i;
+	classes->cr      |= (uint64_t)(uint32_t)_mm256_movemask_epi8(cr) << i;
+	classes->lf      |= (uint64_t)(uint32_t)_mm256_movemask_epi8(lf) << i;
+	classes->illegal |= (uint64_t)(uint32_t)_mm256_movemask_epi8(
+	                        _mm256_or_si256(ctl, del)
+	                    )
+	                    << i;
+}
+
+__attribute__((target("avx2"))) void __lhttp_scan_classify_avx2(
+    const char *p,
+    size_t len,
+    __lhttp_scan_classes_t *classes
+)
+{
+	if (len < 32)
+	{
+		__lhttp_scan_classify_sse2(p, len, classes);
+		return;
+	}
+
+	classes->colon   = 0;
+	classes->cr      = 0;
+	classes->lf      = 0;
+	classes->illegal = 0;
+
+	__lhttp_scan_classify32(p, 0, classes);
+
+	// A full block is two vectors, a shorter one overlaps the first
+	if (len > 32)
+		__lhttp_scan_classify32(p, len - 32, classes);
+}
+
+/* Compare unsigned bytes against any byte of the set, report the first hit */
+#define LHTTP_SSE42_MODE                                                      \
+	(_SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_LEAST_SIGNIFICANT)
+
+int __lhttp_scan_has_sse42(void)
+{
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("sse4.2");
+}
+
+int __lhttp_scan_has_avx2(void)
+{
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2");
+}
+
+__attribute__((target("sse4.2"))) const char *__lhttp_scan_find_sse42(
+    const char *p,
+    const char *end,
+    const char *set,
+    size_t setlen
+)
+{
+	char needles[16] = {0};
+	int n            = (int)setlen;
+	const char *last = end - 16;
+	__m128i setv;
+	int idx;
+
+	// Plain compares beat the string instruction on sets of up to four
+	// bytes, which is most of them
+	if (setlen <= 4)
+		return __lhttp_scan_find_sse2(p, end, set, setlen);
+
+	if (end - p < 16)
+		return __lhttp_scan_bytes(p, end, set, setlen);
+
+	memcpy(needles, set, setlen);
+	setv = _mm_loadu_si128((const __m128i *)needles);
+
+	for (; p < last; p += 16)
+	{
+		__m128i block = _mm_loadu_si128((const __m128i *)p);
+
+		idx = _mm_cmpestri(setv, n, block, 16, LHTTP_SSE42_MODE);
+		if (idx < 16)
+			return p + idx;
+	}
+
+	// The last block overlaps bytes that were already checked, which is
+	// cheaper than finishing byte by byte and never reads past `end`
+	idx = _mm_cmpestri(
+	    setv,
+	    n,
+	    _mm_loadu_si128((const __m128i *)last),
+	    16,
+	    LHTTP_SSE42_MODE
+	);
+
+	return idx < 16 ? last + idx : end;
+}
+
+/* Match mask of a 32-byte block against four needles */
+#define AVX2_MATCH(block, n0, n1, n2, n3)                                     \
+	((uint32_t)_mm256_movemask_epi8(_mm256_or_si256(                          \
+	    _mm256_or_si256(                                                      \
+	        _mm256_cmpeq_epi8(block, n0),                                     \
+	        _mm256_cmpeq_epi8(block, n1)                                      \
+	    ),                                                                    \
+	    _mm256_or_si256(                                                      \
+	        _mm256_cmpeq_epi8(block, n2),                                     \
+	        _mm256_cmpeq_epi8(block, n3)                                      \
+	    )                                                                     \
+	)))
+
+/* Match mask of a 16-byte block against four needles */
+#define SSE2_MATCH(block, n0, n1, n2, n3)                                     \
+	((uint32_t)_mm_movemask_epi8(_mm_or_si128(                                \
+	    _mm_or_si128(_mm_cmpeq_epi8(block, n0), _mm_cmpeq_epi8(block, n1)),   \
+	    _mm_or_si128(_mm_cmpeq_epi8(block, n2), _mm_cmpeq_epi8(block, n3))    \
+	)))
+
+/* Needles 4 to 7 of a set, padded like the first four */
+#define LHTTP_SCAN_NEEDLE_HI(set, setlen, i)                                  \
+	((i) + 4 < (setlen) ? (set)[(i) + 4] : (set)[0])
+
+__attribute__((target("sse2"))) const char *__lhttp_scan_find_sse2(
+    const char *p,
+    const char *end,
+    const char *set,
+    size_t setlen
+)
+{
+	const char *last = end - 16;
+	const int wide   = setlen > 4;
+	uint32_t mask;
+
+	if (end - p < 16 || setlen == 0)
+		return __lhttp_scan_short(p, end, set, setlen);
+
+	const __m128i n0 = _mm_set1_epi8(LHTTP_SCAN_NEEDLE(set, setlen, 0));
+	const __m128i n1 = _mm_set1_epi8(LHTTP_SCAN_NEEDLE(set, setlen, 1));
+	const __m128i n2 = _mm_set1_epi8(LHTTP_SCAN_NEEDLE(set, setlen, 2));
+	const __m128i n3 = _mm_set1_epi8(LHTTP_SCAN_NEEDLE(set, setlen, 3));
+	const __m128i n4 = _mm_set1_epi8(LHTTP_SCAN_NEEDLE_HI(set, setlen, 0));
+	const __m128i n5 = _mm_set1_epi8(LHTTP_SCAN_NEEDLE_HI(set, setlen, 1));
+	const __m128i n6 = _mm_set1_epi8(LHTTP_SCAN_NEEDLE_HI(set, setlen, 2));
+	const __m128i n7 = _mm_set1_epi8(LHTTP_SCAN_NEEDLE_HI(set, setlen, 3));
+	__m128i block;
+
+	// Two blocks per iteration, the second half of the set only when the
+	// set has more than four bytes
+	for (; last - p >= 16; p += 32)
+	{
+		__m128i lo = _mm_loadu_si128((const __m128i *)p);
+		__m128i hi = _mm_loadu_si128((const __m128i *)(p + 16));
+
+		mask = SSE2_MATCH(hi, n0, n1, n2, n3) << 16 |
+		       SSE2_MATCH(lo, n0, n1, n2, n3);
+		if (wide)
+			mask |= SSE2_MATCH(hi, n4, n5, n6, n7) << 16 |
+			        SSE2_MATCH(lo, n4, n5, n6, n7);
+
+		if (mask != 0)
+			return p + __builtin_ctz(mask);
+	}
+
+	if (p < last)
+	{
+		block = _mm_loadu_si128((const __m128i *)p);
+		mask  = SSE2_MATCH(block, n0, n1, n2, n3);
+		if (wide)
+			mask |= SSE2_MATCH(block, n4, n5, n6, n7);
+
+		if (mask != 0)
+			return p + __builtin_ctz(mask);
+	}
+
+	// The last block overlaps bytes that were already checked
+	block = _mm_loadu_si128((const __m128i *)last);
+	mask  = SSE2_MATCH(block, n0, n1, n2, n3);
+	if (wide)
+		mask |= SSE2_MATCH(block, n4, n5, n6, n7);
+
+	return mask != 0 ? last + __builtin_ctz(mask) : end;
+}
+
+__attribute__((target("avx2"))) const char *__lhttp_scan_find_avx2(
+    const char *p,
+    const char *end,
+    const char *set,
+    size_t setlen
+)
+{
+	const char *last = end - 32;
+	const int wide   = setlen > 4;
+	uint32_t mask;
+
+	// Short ranges do not fill a single 32-byte block
+	if (end - p < 32 || setlen == 0)
+		return __lhttp_scan_find_sse2(p, end, set, setlen);
+
+	const __m256i n0 = _mm256_set1_epi8(LHTTP_SCAN_NEEDLE(set, setlen, 0));
+	const __m256i n1 = _mm256_set1_epi8(LHTTP_SCAN_NEEDLE(set, setlen, 1));
+	const __m256i n2 = _mm256_set1_epi8(LHTTP_SCAN_NEEDLE(set, setlen, 2));
+	const __m256i n3 = _mm256_set1_epi8(LHTTP_SCAN_NEEDLE(set, setlen, 3));
+	const __m256i n4 = _mm256_set1_epi8(LHTTP_SCAN_NEEDLE_HI(set, setlen, 0));
+	const __m256i n5 = _mm256_set1_epi8(LHTTP_SCAN_NEEDLE_HI(set, setlen, 1));
+	const __m256i n6 = _mm256_set1_epi8(LHTTP_SCAN_NEEDLE_HI(set, setlen, 2));
+	const __m256i n7 = _mm256_set1_epi8(LHTTP_SCAN_NEEDLE_HI(set, setlen, 3));
+	__m256i block;
+
+	// Two blocks per iteration for long ranges such as big URIs
+	for (; last - p >= 32; p += 64)
+	{
+		__m256i lo  = _mm256_loadu_si256((const __m256i *)p);
+		__m256i hi  = _mm256_loadu_si256((const __m256i *)(p + 32));
+		uint64_t m2 = (uint64_t)AVX2_MATCH(hi, n0, n1, n2, n3) << 32 |
+		              AVX2_MATCH(lo, n0, n1, n2, n3);
+
+		if (wide)
+			m2 |= (uint64_t)AVX2_MATCH(hi, n4, n5, n6, n7) << 32 |
+			      AVX2_MATCH(lo, n4, n5, n6, n7);
+
+		if (m2 != 0)
+			return p + __builtin_ctzll(m2);
+	}
+
+	if (p < last)
+	{
+		block = _mm256_loadu_si256((const __m256i *)p);
+		mask  = AVX2_MATCH(block, n0, n1, n2, n3);
+		if (wide)
+			mask |= AVX2_MATCH(block, n4, n5, n6, n7);
+
+		if (mask != 0)
+			return p + __builtin_ctz(mask);
+	}
+
+	// The last block overlaps bytes that were already checked
+	block = _mm256_loadu_si256((const __m256i *)last);
+	mask  = AVX2_MATCH(block, n0, n1, n2, n3);
+	if (wide)
+		mask |= AVX2_MATCH(block, n4, n5, n6, n7);
+
+	return mask != 0 ? last + __builtin_ctz(mask) : end;
+}
+
+#endif // LHTTP_SCAN_X86
+
+static void __lhttp_classify_resolve(
+    const char *p,
+    size_t len,
+    __lhttp_scan_classes_t *classes
+)
+{
+	__lhttp_classify_fn impl = __lhttp_scan_classify_scalar;
+
+#ifdef LHTTP_SCAN_X86
+	if (__lhttp_scan_has_avx2())
+	{
+		impl = __lhttp_scan_classify_avx2;
+	}
+	else if (__lhttp_scan_has_sse2())
+	{
+		impl = __lhttp_scan_classify_sse2;
+	}
+#endif
+
+	__lhttp_classify_impl = impl;
+
+	impl(p, len, classes);
+}
+
+static const char *
+__lhttp_scan_resolve(const char *p, const char *end, const char *set, size_t n)
+{
+	__lhttp_scan_fn impl = __lhttp_scan_find_scalar;
+	const char *name     = "scalar";
+
+#ifdef LHTTP_SCAN_X86
+	if (__lhttp_scan_has_avx2())
+	{
+		impl = __lhttp_scan_find_avx2;
+		name = "avx2";
+	}
+	else if (__lhttp_scan_has_sse42())
+	{
+		impl = __lhttp_scan_find_sse42;
+		name = "sse4.2";
+	}
+	else if (__lhttp_scan_has_sse2())
+	{
+		impl = __lhttp_scan_find_sse2;
+		name = "sse2";
+	}
+#endif
+
+	__lhttp_scan_name = name;
+	__lhttp_scan_impl = impl;
+
+	return impl(p, end, set, n);
+}
@@ -0,0 +1,186 @@
+/* src/lhttp_scan.h
+ *
+ * Copyright (c) 2024 libhttp. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/* Private delimiter scanner shared by the parsers. This header is not part of
+ * the public API and is not installed. */
+
+#ifndef LIBHTTP_SCAN_H
+#define LIBHTTP_SCAN_H 1
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* x86 vector paths are compiled with per-function target attributes, so the
+ * library itself does not need to be built with -mavx2. Defining
+ * `LHTTP_NO_SIMD` forces the scalar scanner everywhere. */
+#if !defined(LHTTP_NO_SIMD) && defined(__GNUC__) &&                           \
+    (defined(__x86_64__) || defined(__i386__))
+#define LHTTP_SCAN_X86 1
+#endif
+
+/* Maximum number of distinct bytes in a scan set */
+#define LHTTP_SCAN_SET_MAX 8
+
+/**
+ * @brief Signature shared by all scanner implementations
+ */
+typedef const char *(*__lhttp_scan_fn)(
+    const char *p,
+    const char *end,
+    const char *set,
+    size_t setlen
+);
+
+/* Implementation picked at runtime, see `__lhttp_scan_find` */
+extern __lhttp_scan_fn __lhttp_scan_impl;
+
+/**
+ * @brief Find the first byte in `[p, end)` that is one of the bytes in `set`
+ *
+ * @param p Beginning of the range to scan
+ * @param end One past the last byte of the range
+ * @param set NUL-terminated string of 1 to `LHTTP_SCAN_SET_MAX` bytes
+ * @return A pointer to the first matching byte, or `end` if there is none
+ *
+ * @note Unlike `strpbrk`, the range does not need to be NUL-terminated and no
+ * byte past `end` is ever read. The implementation (AVX2, SSE4.2, SSE2 or
+ * scalar) is picked once at runtime from the CPU features.
+ */
+static inline const char *
+__lhttp_scan_find(const char *p, const char *end, const char *set)
+{
+	return __lhttp_scan_impl(p, end, set, strlen(set));
+}
+
+/* Largest block classified at once, one bit per byte of a 64-bit mask */
+#define LHTTP_SCAN_BLOCK 64
+
+/**
+ * @brief Bytes of interest in one block of a header section, bit `i` of each
+ * mask standing for byte `i` of the block
+ */
+typedef struct __lhttp_scan_classes_s
+{
+	uint64_t colon;   // ':', ending field names
+	uint64_t cr;      // '\r'
+	uint64_t lf;      // '\n'
+	uint64_t illegal; // CTLs other than HTAB, CR and LF, and DEL
+} __lhttp_scan_classes_t;
+
+/**
+ * @brief Signature shared by all classifier implementations
+ */
+typedef void (*__lhttp_classify_fn)(
+    const char *p,
+    size_t len,
+    __lhttp_scan_classes_t *classes
+);
+
+/* Implementation picked at runtime, see `__lhttp_scan_classify` */
+extern __lhttp_classify_fn __lhttp_classify_impl;
+
+/**
+ * @brief Classify the `len` bytes at `p`, at most `LHTTP_SCAN_BLOCK`
+ *
+ * @param p Beginning of the block
+ * @param len Length of the block. No byte past `p + len` is read.
+ * @param classes A pointer to store the masks of the block
+ *
+ * @note The colons, the line ends and the bytes no field line may hold are
+ * found in the same pass, with one movemask per class and per vector. The
+ * implementation (AVX2, SSE2 or scalar) is picked once at runtime.
+ */
+static inline void __lhttp_scan_classify(
+    const char *p,
+    size_t len,
+    __lhttp_scan_classes_t *classes
+)
+{
+	__lhttp_classify_impl(p, len, classes);
+}
+
+/**
+ * @brief Get the name of the scanner implementation picked at runtime
+ *
+ * @return "avx2", "sse4.2", "sse2" or "scalar"
+ */
+const char *__lhttp_scan_impl_name(void);
+
+/* Individual implementations, exposed for tests and benchmarks only */
+
+const char *__lhttp_scan_find_scalar(
+    const char *p,
+    const char *end,
+    const char *set,
+    size_t setlen
+);
+
+void __lhttp_scan_classify_scalar(
+    const char *p,
+    size_t len,
+    __lhttp_scan_classes_t *classes
+);
+
+#ifdef LHTTP_SCAN_X86
+const char *__lhttp_scan_find_sse2(
+    const char *p,
+    const char *end,
+    const char *set,
+    size_t setlen
+);
+
+const char *__lhttp_scan_find_sse42(
+    const char *p,
+    const char *end,
+    const char *set,
+    size_t setlen
+);
+
+const char *__lhttp_scan_find_avx2(
+    const char *p,
+    const char *end,
+    const char *set,
+    size_t setlen
+);
+
+void __lhttp_scan_classify_sse2(
+    const char *p,
+    size_t len,
+    __lhttp_scan_classes_t *classes
+);
+
+void __lhttp_scan_classify_avx2(
+    const char *p,
+    size_t len,
+    __lhttp_scan_classes_t *classes
+);
+
+int __lhttp_scan_has_sse2(void);
+int __lhttp_scan_has_sse42(void);
+int __lhttp_scan_has_avx2(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LIBHTTP_SCAN_H
@@ -0,0 +1,195 @@
+/* src/lhttp_token.h
+ *
+ * Copyright (c) 2024 libhttp. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/* Private decoders for the method and version tokens of the request line.
+ * Tokens are loaded as 32- or 64-bit words and compared against constants,
+ * instead of going through a chain of `strncmp`. */
+
+#ifndef LIBHTTP_TOKEN_H
+#define LIBHTTP_TOKEN_H 1
+
+#include <lhttp_request.h>
+
+#include "lhttp_char_class.h"
+
+/* Word made of the bytes a, b, c, d in memory order */
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define LHTTP_WORD4(a, b, c, d)                                               \
+	((uint32_t)(a) << 24 | (uint32_t)(b) << 16 | (uint32_t)(c) << 8 |         \
+	 (uint32_t)(d))
+#else
+#define LHTTP_WORD4(a, b, c, d)                                               \
+	((uint32_t)(a) | (uint32_t)(b) << 8 | (uint32_t)(c) << 16 |               \
+	 (uint32_t)(d) << 24)
+#endif
+
+/* Word made of the 8 bytes of "HTTP/x.y" in memory order */
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define LHTTP_VERSION_WORD(x, y)                                              \
+	((uint64_t)LHTTP_WORD4('H', 'T', 'T', 'P') << 32 |                        \
+	 LHTTP_WORD4('/', x, '.', y))
+#else
+#define LHTTP_VERSION_WORD(x, y)                                              \
+	((uint64_t)LHTTP_WORD4('/', x, '.', y) << 32 |                            \
+	 LHTTP_WORD4('H', 'T', 'T', 'P'))
+#endif
+
+static inline uint32_t __lhttp_load32(const char *p)
+{
+	uint32_t word;
+
+	memcpy(&word, p, sizeof(word));
+	return word;
+}
+
+static inline uint64_t __lhttp_load64(const char *p)
+{
+	uint64_t word;
+
+	memcpy(&word, p, sizeof(word));
+	return word;
+}
+
+/**
+ * @brief Check whether `c` is a token character (tchar) as of RFC 9110
+ */
+static inline bool __lhttp_is_tchar(unsigned char c)
+{
+	return __lhttp_char_class[c] & LHTTP_CHAR_TCHAR;
+}
+
+/**
+ * @brief Decode the method token `[m, m + len)`
+ *
+ * @param m Start of the method. `m[len]` must be readable, which holds in the
+ * request line since the method is always followed by a SP.
+ * @param len Length of the method
+ * @return The method, `LHTTP_METHOD_EXTENSION` for any other valid token, or
+ * `LHTTP_METHOD_INVALID` if the method is not a token
+ */
+static inline lhttp_method_t __lhttp_method_decode(const char *m, size_t len)
+{
+	uint32_t head, tail;
+	size_t i;
+
+	if (len >= 3 && len <= 7)
+	{
+		// Methods of 3 bytes are compared with their trailing SP. Longer ones
+		// are covered by a head and a tail word, which overlap below 8 bytes.
+		head = __lhttp_load32(m);
+		tail = __lhttp_load32(m + (len > 4 ? len - 4 : 0));
+
+		switch (len)
+		{
+		case 3:
+			if (head == LHTTP_WORD4('G', 'E', 'T', ' '))
+				return LHTTP_METHOD_GET;
+			if (head == LHTTP_WORD4('P', 'U', 'T', ' '))
+				return LHTTP_METHOD_PUT;
+			break;
+
+		case 4:
+			if (head == LHTTP_WORD4('P', 'O', 'S', 'T'))
+				return LHTTP_METHOD_POST;
+			if (head == LHTTP_WORD4('H', 'E', 'A', 'D'))
+				return LHTTP_METHOD_HEAD;
+			break;
+
+		case 5:
+			if (head == LHTTP_WORD4('P', 'A', 'T', 'C') &&
+			    tail == LHTTP_WORD4('A', 'T', 'C', 'H'))
+				return LHTTP_METHOD_PATCH;
+			if (head == LHTTP_WORD4('T', 'R', 'A', 'C') &&
+			    tail == LHTTP_WORD4('R', 'A', 'C', 'E'))
+				return LHTTP_METHOD_TRACE;
+			break;
+
+		case 6:
+			if (head == LHTTP_WORD4('D', 'E', 'L', 'E') &&
+			    tail == LHTTP_WORD4('L', 'E', 'T', 'E'))
+				return LHTTP_METHOD_DELETE;
+			break;
+
+		case 7:
+			if (head == LHTTP_WORD4('O', 'P', 'T', 'I') &&
+			    tail == LHTTP_WORD4('I', 'O', 'N', 'S'))
+				return LHTTP_METHOD_OPTIONS;
+			if (head == LHTTP_WORD4('C', 'O', 'N', 'N') &&
+			    tail == LHTTP_WORD4('N', 'E', 'C', 'T'))
+				return LHTTP_METHOD_CONNECT;
+			break;
+		}
+	}
+
+	// Extension methods, and the standard ones in another case, which are
+	// distinct methods since method names are case-sensitive
+	for (i = 0; i < len; i++)
+	{
+		if (!__lhttp_is_tchar((unsigned char)m[i]))
+			return LHTTP_METHOD_INVALID;
+	}
+
+	return len > 0 ? LHTTP_METHOD_EXTENSION : LHTTP_METHOD_INVALID;
+}
+
+/**
+ * @brief Decode the version token `[v, v + len)`
+ *
+ * @param v Start of the version
+ * @param len Length of the version
+ * @param version A pointer to store the decoded version
+ * @return 0 if the token is a well-formed HTTP-version, -1 otherwise
+ *
+ * @note Well-formed versions other than HTTP/1.0 and HTTP/1.1 are decoded as
+ * `LHTTP_VERSION_INVALID` without failing, so that the caller can tell them
+ * apart from garbage and answer 505 instead of 400.
+ */
+static inline int
+__lhttp_version_decode(const char *v, size_t len, lhttp_version_t *version)
+{
+	uint64_t word;
+
+	*version = LHTTP_VERSION_INVALID;
+
+	if (len != 8)
+		return -1;
+
+	word = __lhttp_load64(v);
+
+	if (word == LHTTP_VERSION_WORD('1', '1'))
+	{
+		*version = LHTTP_VERSION_1_1;
+		return 0;
+	}
+
+	if (word == LHTTP_VERSION_WORD('1', '0'))
+	{
+		*version = LHTTP_VERSION_1_0;
+		return 0;
+	}
+
+	// Any other HTTP-version: "HTTP/" DIGIT "." DIGIT
+	if (__lhttp_load32(v) != LHTTP_WORD4('H', 'T', 'T', 'P') || v[4] != '/' ||
+	    v[5] < '0' || v[5] > '9' || v[6] != '.' || v[7] < '0' || v[7] > '9')
+	{
+		return -1;
+	}
+
+	return 0;
+}
+
+#endif // LIBHTTP_TOKEN_H
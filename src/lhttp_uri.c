@@ -0,0 +1,194 @@
+/* Copyright (c) 2024 libhttp. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <lhttp_uri.h>
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "lhttp_char_class.h"
+#include "lhttp_scan.h"
+
+int lhttp_uri_decode(
+    char *data,
+    size_t len,
+    lhttp_uri_decode_mode_t mode,
+    size_t *decoded_len
+)
+{
+	const bool form = mode == LHTTP_URI_DECODE_FORM;
+	const char *set = form ? "%+" : "%";
+	const char plus = form ? '+' : '%';
+	char *end       = data + len;
+	char *r, *w;
+	size_t run;
+	unsigned char hi, lo, c;
+
+	if (data == NULL || decoded_len == NULL)
+	{
+		return -1;
+	}
+
+	// Nothing is written before the first byte to decode
+	r = data + (__lhttp_scan_find(data, end, set) - data);
+	w = r;
+
+	while (r < end)
+	{
+		// Escapes often come back to back, as in UTF-8 sequences, so they
+		// are decoded without going through the scanner in between
+		do
+		{
+			if (*r == '%')
+			{
+				if (end - r < 3)
+				{
+					return -1;
+				}
+
+				hi = __lhttp_hex_digit[(unsigned char)r[1]];
+				lo = __lhttp_hex_digit[(unsigned char)r[2]];
+
+				// Invalid digits are 0xff, and "%00" would cut C strings
+				if ((hi | lo) > 0xF || (hi | lo) == 0)
+				{
+					return -1;
+				}
+
+				// A path would gain a separator it was not normalized with
+				c = hi << 4 | lo;
+				if (!form && (c == '/' || c == '\\'))
+				{
+					return -1;
+				}
+
+				*w++ = (char)c;
+				r   += 3;
+			}
+			else
+			{
+				*w++ = ' ';
+				r++;
+			}
+		} while (r < end && (*r == '%' || *r == plus));
+
+		// Then the run of literal bytes up to the next one moves down
+		run = __lhttp_scan_find(r, end, set) - r;
+		memmove(w, r, run);
+		w += run;
+		r += run;
+	}
+
+	*decoded_len = w - data;
+
+	return 0;
+}
+
+/**
+ * @brief Count the dots of the dot-segment `[p, end)`, written as '.' or as
+ * "%2e"
+ *
+ * @return 1 for ".", 2 for "..", 0 for any other segment
+ */
+static inline int __lhttp_uri_dots(const char *p, const char *end)
+{
+	int dots = 0;
+
+	while (p < end && dots < 3)
+	{
+		if (*p == '.')
+		{
+			p++;
+		}
+		else if (end - p >= 3 && p[0] == '%' && p[1] == '2' &&
+		         (p[2] | 0x20) == 'e')
+		{
+			p += 3;
+		}
+		else
+		{
+			return 0;
+		}
+
+		dots++;
+	}
+
+	return dots < 3 ? dots : 0;
+}
+
+int lhttp_uri_normalize_path(char *path, size_t len, size_t *normalized_len)
+{
+	char *end = path + len;
+	char *r   = path;
+	char *w   = path;
+	char *segment, *next;
+	int dots;
+
+	if (path == NULL || normalized_len == NULL ||
+	    (len > 0 && path[0] != '/'))
+	{
+		return -1;
+	}
+
+	// `r` is on the slash of a segment, `w` right after the output so far.
+	// While nothing was removed, they stay equal and nothing is written.
+	while (r < end)
+	{
+		for (segment = r + 1; segment < end && *segment == '/'; segment++)
+			;
+
+		for (next = segment; next < end && *next != '/'; next++)
+			;
+
+		dots = __lhttp_uri_dots(segment, next);
+
+		if (dots == 2)
+		{
+			// Drop the last output segment, which the root does not have
+			if (w == path)
+			{
+				return -1;
+			}
+
+			for (w--; *w != '/'; w--)
+				;
+		}
+
+		if (dots > 0)
+		{
+			// The directory the path ends in keeps its slash
+			if (next == end)
+			{
+				*w++ = '/';
+			}
+		}
+		else if (w == r && segment == r + 1)
+		{
+			w = next;
+		}
+		else
+		{
+			*w = '/';
+			memmove(w + 1, segment, next - segment);
+			w += 1 + (next - segment);
+		}
+
+		r = next;
+	}
+
+	*normalized_len = w - path;
+
+	return 0;
+}
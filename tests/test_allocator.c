@@ -0,0 +1,194 @@
+/* Copyright (c) 2024 libhttp. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <lhttp_allocator.h>
+#include <lhttp_list.h>
+#include <lhttp_request.h>
+#include <string.h>
+#include <unity/unity.h>
+#include <unity/unity_fixture.h>
+
+TEST_GROUP(TEST_ALLOCATOR);
+
+/* Counting allocator that checks the sizes given back by the library */
+struct counter
+{
+	size_t allocations;
+	size_t frees;
+	size_t live_bytes;
+};
+
+static void *counting_malloc(void *ctx, size_t size)
+{
+	struct counter *c = ctx;
+
+	c->allocations++;
+	c->live_bytes += size;
+
+	return malloc(size);
+}
+
+static void *
+counting_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size)
+{
+	struct counter *c = ctx;
+
+	c->live_bytes = c->live_bytes - old_size + new_size;
+
+	return realloc(ptr, new_size);
+}
+
+static void counting_free(void *ctx, void *ptr, size_t size)
+{
+	struct counter *c = ctx;
+
+	c->frees++;
+	c->live_bytes -= size;
+
+	free(ptr);
+}
+
+struct counter counter;
+lhttp_allocator_t allocator;
+
+// Run before each test
+TEST_SETUP(TEST_ALLOCATOR)
+{
+	memset(&counter, 0, sizeof(counter));
+
+	allocator.malloc_fn  = counting_malloc;
+	allocator.realloc_fn = counting_realloc;
+	allocator.free_fn    = counting_free;
+	allocator.ctx        = &counter;
+}
+
+// Run after each test
+TEST_TEAR_DOWN(TEST_ALLOCATOR) {}
+
+TEST(TEST_ALLOCATOR, RequestAllocator)
+{
+	lhttp_request_t request;
+	const char *message = "GET / HTTP/1.1\r\nHost: example.com\r\n\r\n";
+	int s;
+
+	s = lhttp_request_init_with_allocator(&request, 256, &allocator);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    0,
+	    s,
+	    "Request initialization is expected to be successful"
+	);
+	TEST_ASSERT_EQUAL_size_t_MESSAGE(
+	    1,
+	    counter.allocations,
+	    "Buffer is expected to come from the allocator"
+	);
+
+	s = lhttp_request_parse(&request, message, strlen(message));
+	TEST_ASSERT_EQUAL_INT_MESSAGE(0, s, "Parsing is expected to succeed");
+
+	lhttp_request_free(&request);
+	TEST_ASSERT_EQUAL_size_t_MESSAGE(
+	    1,
+	    counter.frees,
+	    "Buffer is expected to go back to the allocator"
+	);
+	TEST_ASSERT_EQUAL_size_t_MESSAGE(
+	    0,
+	    counter.live_bytes,
+	    "Buffer is expected to be freed with its allocated size"
+	);
+
+	TEST_PASS_MESSAGE("RequestAllocator passed");
+}
+
+TEST(TEST_ALLOCATOR, ListAllocator)
+{
+	lhttp_list_t list;
+	lhttp_list_status_t s;
+
+	s = lhttp_list_init_with_allocator(&list, &allocator);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    LHTTP_LIST_OK,
+	    s,
+	    "List initialization is expected to be successful"
+	);
+
+	lhttp_list_add(&list, "Host", "example.com");
+	lhttp_list_add(&list, "Accept", "*/*");
+	lhttp_list_add(&list, "Connection", "close");
+	lhttp_list_remove(&list, "Accept");
+
+	TEST_ASSERT_NOT_EQUAL_MESSAGE(
+	    0,
+	    counter.allocations,
+	    "List memory is expected to come from the allocator"
+	);
+
+	lhttp_list_free(&list);
+	TEST_ASSERT_EQUAL_size_t_MESSAGE(
+	    counter.allocations,
+	    counter.frees,
+	    "Every allocation is expected to be freed"
+	);
+	TEST_ASSERT_EQUAL_size_t_MESSAGE(
+	    0,
+	    counter.live_bytes,
+	    "Every block is expected to be freed with its allocated size"
+	);
+
+	TEST_PASS_MESSAGE("ListAllocator passed");
+}
+
+TEST(TEST_ALLOCATOR, DefaultAllocator)
+{
+	lhttp_list_t list;
+	lhttp_request_t request;
+
+	// NULL picks the libc allocator
+	lhttp_list_init_with_allocator(&list, NULL);
+	TEST_ASSERT_EQUAL_PTR_MESSAGE(
+	    &lhttp_allocator_libc,
+	    list.__allocator,
+	    "List is expected to use the libc allocator by default"
+	);
+	lhttp_list_free(&list);
+
+	lhttp_request_init(&request, 16);
+	TEST_ASSERT_EQUAL_PTR_MESSAGE(
+	    &lhttp_allocator_libc,
+	    request.__allocator,
+	    "Request is expected to use the libc allocator by default"
+	);
+	lhttp_request_free(&request);
+
+	TEST_PASS_MESSAGE("DefaultAllocator passed");
+}
+
+TEST_GROUP_RUNNER(TEST_ALLOCATOR)
+{
+	RUN_TEST_CASE(TEST_ALLOCATOR, RequestAllocator);
+	RUN_TEST_CASE(TEST_ALLOCATOR, ListAllocator);
+	RUN_TEST_CASE(TEST_ALLOCATOR, DefaultAllocator);
+}
+
+static void RunAllTests(void)
+{
+	RUN_TEST_GROUP(TEST_ALLOCATOR);
+}
+
+int main(int argc, const char *argv[])
+{
+	return UnityMain(argc, argv, RunAllTests);
+}
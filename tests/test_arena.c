@@ -0,0 +1,173 @@
+/* Copyright (c) 2024 libhttp. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <lhttp_arena.h>
+#include <lhttp_list.h>
+#include <lhttp_request.h>
+#include <stdint.h>
+#include <string.h>
+#include <unity/unity.h>
+#include <unity/unity_fixture.h>
+
+TEST_GROUP(TEST_ARENA);
+
+lhttp_arena_t arena;
+
+// Run before each test
+TEST_SETUP(TEST_ARENA)
+{
+	lhttp_arena_init(&arena, 256, NULL);
+}
+
+// Run after each test
+TEST_TEAR_DOWN(TEST_ARENA)
+{
+	lhttp_arena_free(&arena);
+}
+
+TEST(TEST_ARENA, AllocateBlocks)
+{
+	char *a, *b, *big;
+	size_t i;
+
+	a = lhttp_arena_alloc(&arena, 3);
+	b = lhttp_arena_alloc(&arena, 5);
+
+	TEST_ASSERT_NOT_NULL_MESSAGE(a, "Block is expected to be allocated");
+	TEST_ASSERT_EQUAL_PTR_MESSAGE(
+	    a + LHTTP_ARENA_ALIGN,
+	    b,
+	    "Consecutive blocks are expected to be bumped from the same chunk"
+	);
+
+	// Blocks keep their alignment across chunk boundaries
+	for (i = 0; i < 100; i++)
+	{
+		char *block = lhttp_arena_alloc(&arena, i);
+
+		TEST_ASSERT_NOT_NULL_MESSAGE(block, "Block is expected to exist");
+		TEST_ASSERT_EQUAL_size_t_MESSAGE(
+		    0,
+		    (uintptr_t)block % LHTTP_ARENA_ALIGN,
+		    "Block is expected to be aligned"
+		);
+		memset(block, 'x', i);
+	}
+
+	// A block larger than a chunk gets a chunk of its own
+	big = lhttp_arena_alloc(&arena, 4096);
+	TEST_ASSERT_NOT_NULL_MESSAGE(big, "Large block is expected to exist");
+	memset(big, 'x', 4096);
+
+	TEST_PASS_MESSAGE("AllocateBlocks passed");
+}
+
+TEST(TEST_ARENA, ResetArena)
+{
+	char *first, *again;
+	size_t i;
+
+	first = lhttp_arena_alloc(&arena, 16);
+	for (i = 0; i < 64; i++)
+		lhttp_arena_alloc(&arena, 100);
+
+	lhttp_arena_reset(&arena);
+
+	// Memory is reused from the first chunk on
+	again = lhttp_arena_alloc(&arena, 16);
+	TEST_ASSERT_EQUAL_PTR_MESSAGE(
+	    first,
+	    again,
+	    "Reset is expected to rewind to the first chunk"
+	);
+
+	TEST_PASS_MESSAGE("ResetArena passed");
+}
+
+TEST(TEST_ARENA, ArenaAllocator)
+{
+	const lhttp_allocator_t *allocator = lhttp_arena_allocator(&arena);
+	lhttp_request_t request;
+	lhttp_list_t headers;
+	const char *message = "GET / HTTP/1.1\r\nHost: example.com\r\n\r\n";
+	char *value, *block, *grown;
+	int s;
+
+	// The last block grows in place
+	block = allocator->malloc_fn(allocator->ctx, 8);
+	memcpy(block, "abcdefg", 8);
+	grown = allocator->realloc_fn(allocator->ctx, block, 8, 32);
+	TEST_ASSERT_EQUAL_PTR_MESSAGE(
+	    block,
+	    grown,
+	    "Last block is expected to be resized in place"
+	);
+	TEST_ASSERT_EQUAL_STRING_MESSAGE(
+	    "abcdefg",
+	    grown,
+	    "Resized block is expected to keep its content"
+	);
+	allocator->free_fn(allocator->ctx, grown, 32);
+
+	s = lhttp_request_init_with_allocator(&request, 128, allocator);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(0, s, "Request initialization is expected");
+	s = lhttp_request_parse(&request, message, strlen(message));
+	TEST_ASSERT_EQUAL_INT_MESSAGE(0, s, "Parsing is expected to succeed");
+
+	s = lhttp_list_init_with_allocator(&headers, allocator);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    LHTTP_LIST_OK,
+	    s,
+	    "List is expected to be initialized"
+	);
+	lhttp_list_add(&headers, "Host", "example.com");
+
+	s = lhttp_list_get(&headers, "Host", &value);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(LHTTP_LIST_OK, s, "Host is expected");
+	TEST_ASSERT_EQUAL_STRING_MESSAGE(
+	    "example.com",
+	    value,
+	    "Host is expected to be equal to 'example.com'"
+	);
+
+	TEST_ASSERT_EQUAL_PTR_MESSAGE(
+	    allocator,
+	    request.__allocator,
+	    "Request buffer is expected to come from the arena"
+	);
+
+	// Everything goes away with the arena
+	lhttp_list_free(&headers);
+	lhttp_request_free(&request);
+
+	TEST_PASS_MESSAGE("ArenaAllocator passed");
+}
+
+TEST_GROUP_RUNNER(TEST_ARENA)
+{
+	RUN_TEST_CASE(TEST_ARENA, AllocateBlocks);
+	RUN_TEST_CASE(TEST_ARENA, ResetArena);
+	RUN_TEST_CASE(TEST_ARENA, ArenaAllocator);
+}
+
+static void RunAllTests(void)
+{
+	RUN_TEST_GROUP(TEST_ARENA);
+}
+
+int main(int argc, const char *argv[])
+{
+	return UnityMain(argc, argv, RunAllTests);
+}
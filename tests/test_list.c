@@ -13,7 +13,10 @@
  * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  */
 
+#include <lhttp_hash.h>
 #include <lhttp_list.h>
+#include <stdio.h>
+#include <string.h>
 #include <unity/unity.h>
 #include <unity/unity_fixture.h>
 
@@ -61,23 +64,15 @@ TEST(TEST_LIST, InitializeList)
 	    "List state is expected to be initialized"
 	);
 
-	// Check if the head is initialized correctly
-	TEST_ASSERT_NOT_NULL_MESSAGE(
-	    list->__head,
-	    "List head is expected to be not NULL"
+	// Check that nothing is allocated before the first entry
+	TEST_ASSERT_NULL_MESSAGE(
+	    list->__entries,
+	    "List entries are expected to be NULL"
 	);
 
-	// Check if the tail is initialized correctly
-	TEST_ASSERT_NOT_NULL_MESSAGE(
-	    list->__tail,
-	    "List tail is expected to be not NULL"
-	);
-
-	// Check if the head is the tail after initialization
-	TEST_ASSERT_EQUAL_PTR_MESSAGE(
-	    list->__head,
-	    list->__tail,
-	    "List head and tail are expected to be different"
+	TEST_ASSERT_NULL_MESSAGE(
+	    list->__slots,
+	    "List index is expected to be NULL"
 	);
 
 	TEST_PASS_MESSAGE("InitializeList passed");
@@ -378,12 +373,927 @@ TEST(TEST_LIST, RemoveNode)
 	TEST_PASS_MESSAGE("RemoveNode passed");
 }
 
+TEST(TEST_LIST, InlineNodes)
+{
+	char key[32];
+	char *found;
+	size_t i;
+
+	// The first entries stay inside the list structure
+	for (i = 0; i < LHTTP_LIST_INLINE_SIZE; i++)
+	{
+		snprintf(key, sizeof(key), "X-Header-%zu", i);
+		lhttp_list_add(list, key, "inline");
+	}
+
+	TEST_ASSERT_NULL_MESSAGE(
+	    list->__entries,
+	    "Entries are expected to be stored inline"
+	);
+	TEST_ASSERT_NULL_MESSAGE(
+	    list->__slots,
+	    "Inline entries are expected to be scanned, not indexed"
+	);
+
+	// Holes left by removals are reclaimed without spilling
+	lhttp_list_remove(list, "X-Header-0");
+	lhttp_list_remove(list, "X-Header-1");
+	lhttp_list_add(list, "Host", "localhost:8080");
+
+	TEST_ASSERT_NULL_MESSAGE(
+	    list->__entries,
+	    "Entries are expected to stay inline after a compaction"
+	);
+
+	// One more entry moves the storage to the heap
+	for (i = 0; list->__entries == NULL; i++)
+	{
+		snprintf(key, sizeof(key), "X-Spill-%zu", i);
+		lhttp_list_add(list, key, "heap");
+	}
+
+	TEST_ASSERT_NOT_NULL_MESSAGE(
+	    list->__slots,
+	    "Heap entries are expected to be indexed"
+	);
+
+	status = lhttp_list_get(list, "Host", &found);
+	TEST_ASSERT_EQUAL_STRING_MESSAGE(
+	    "localhost:8080",
+	    found,
+	    "Inline entries are expected to be moved to the heap"
+	);
+
+	status = lhttp_list_get(list, "X-Header-1", &found);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    LHTTP_LIST_ERROR,
+	    status,
+	    "Removed node is expected to be gone"
+	);
+
+	TEST_PASS_MESSAGE("InlineNodes passed");
+}
+
+TEST(TEST_LIST, BorrowedNodes)
+{
+	const char block[] = "Host: localhost:8080\r\nAccept: */*\r\n";
+	const char *value;
+	size_t value_len;
+
+	// Views straight into a header block, nothing is NUL-terminated
+	status = lhttp_list_add_borrowed(list, block, 4, block + 6, 14);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    LHTTP_LIST_OK,
+	    status,
+	    "Adding a borrowed node is expected to be successful"
+	);
+
+	status = lhttp_list_add_borrowed(list, block + 22, 6, block + 30, 3);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    LHTTP_LIST_OK,
+	    status,
+	    "Adding a borrowed node is expected to be successful"
+	);
+
+	// A copied entry with the same bytes is still a duplicate
+	status = lhttp_list_add_n(list, "Hostname", 4, "other", 5);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    LHTTP_LIST_ERROR_KEY_EXISTS,
+	    list->error,
+	    "Error is expected to be key exists"
+	);
+
+	status = lhttp_list_get_n(list, "Accept-Language", 6, &value, &value_len);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    LHTTP_LIST_OK,
+	    status,
+	    "Getting a node by length is expected to be successful"
+	);
+	TEST_ASSERT_EQUAL_PTR_MESSAGE(
+	    block + 30,
+	    value,
+	    "Borrowed value is expected to point into the caller's buffer"
+	);
+	TEST_ASSERT_EQUAL_size_t_MESSAGE(
+	    3,
+	    value_len,
+	    "Borrowed value length is expected to be 3"
+	);
+
+	// A prefix of a key is a different key
+	status = lhttp_list_get_n(list, "Hos", 3, &value, &value_len);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    LHTTP_LIST_ERROR,
+	    status,
+	    "Getting a key prefix is expected to be an error"
+	);
+
+	status = lhttp_list_remove_n(list, block, 4);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    LHTTP_LIST_OK,
+	    status,
+	    "Removing a borrowed node is expected to be successful"
+	);
+	TEST_ASSERT_EQUAL_STRING_MESSAGE(
+	    "Host: localhost:8080\r\nAccept: */*\r\n",
+	    block,
+	    "Caller's buffer is expected to be left untouched"
+	);
+
+	TEST_PASS_MESSAGE("BorrowedNodes passed");
+}
+
+TEST(TEST_LIST, CaseInsensitiveNodes)
+{
+	const char *names[] = {
+	    "Content-Length",
+	    "Access-Control-Allow-Credentials",
+	    "X-Forwarded-For",
+	    "Sec-WebSocket-Extensions",
+	};
+	const char *lookups[] = {
+	    "content-length",
+	    "ACCESS-CONTROL-ALLOW-CREDENTIALS",
+	    "x-fORWARDED-fOR",
+	    "sec-websocket-extensions",
+	};
+	char key[32];
+	char *value;
+	size_t i, round;
+
+	status = lhttp_list_set_flags(list, LHTTP_LIST_CASE_INSENSITIVE);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    LHTTP_LIST_OK,
+	    status,
+	    "Setting flags on an empty list is expected to be successful"
+	);
+
+	// Once with inline entries, once with indexed ones
+	for (round = 0; round < 2; round++)
+	{
+		for (i = 0; i < 4; i++)
+		{
+			lhttp_list_add(list, names[i], names[i]);
+		}
+
+		for (i = 0; i < 4; i++)
+		{
+			status = lhttp_list_get(list, lookups[i], &value);
+			TEST_ASSERT_EQUAL_INT_MESSAGE(
+			    LHTTP_LIST_OK,
+			    status,
+			    "Keys are expected to match regardless of case"
+			);
+			TEST_ASSERT_EQUAL_STRING_MESSAGE(
+			    names[i],
+			    value,
+			    "Value is expected to be the one of the key"
+			);
+
+			status = lhttp_list_add(list, lookups[i], "duplicate");
+			TEST_ASSERT_EQUAL_INT_MESSAGE(
+			    LHTTP_LIST_ERROR_KEY_EXISTS,
+			    list->error,
+			    "Keys differing only in case are expected to be duplicates"
+			);
+		}
+
+		// Only letters are folded
+		status = lhttp_list_get(list, "Content-Length\x20", NULL);
+		TEST_ASSERT_EQUAL_INT_MESSAGE(
+		    LHTTP_LIST_ERROR,
+		    status,
+		    "Keys of other lengths are expected to differ"
+		);
+		status = lhttp_list_get(list, "Access-Control-Allow-Credentialr", NULL);
+		TEST_ASSERT_EQUAL_INT_MESSAGE(
+		    LHTTP_LIST_ERROR,
+		    status,
+		    "Long keys are expected to be compared to the last byte"
+		);
+		status = lhttp_list_get(list, "X\x0d" "Forwarded-For", NULL);
+		TEST_ASSERT_EQUAL_INT_MESSAGE(
+		    LHTTP_LIST_ERROR,
+		    status,
+		    "Non-letters are expected not to be folded"
+		);
+
+		for (i = 0; i < 4; i++)
+		{
+			lhttp_list_remove(list, lookups[i]);
+		}
+
+		// Move the storage to the heap for the second round
+		for (i = 0; list->__entries == NULL; i++)
+		{
+			snprintf(key, sizeof(key), "X-Filler-%zu", i);
+			lhttp_list_add(list, key, "filler");
+		}
+	}
+
+	status = lhttp_list_set_flags(list, 0);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    LHTTP_LIST_ERROR_NOT_EMPTY,
+	    list->error,
+	    "Setting flags on a list with entries is expected to be an error"
+	);
+
+	TEST_PASS_MESSAGE("CaseInsensitiveNodes passed");
+}
+
+TEST(TEST_LIST, MultimapNodes)
+{
+	const char *cookies[] = {"a=1", "b=2", "c=3", "d=4"};
+	lhttp_list_match_t match;
+	char key[32];
+	char *value;
+	const char *found;
+	size_t i, round, found_len;
+
+	status = lhttp_list_set_flags(
+	    list,
+	    LHTTP_LIST_MULTIMAP | LHTTP_LIST_CASE_INSENSITIVE
+	);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    LHTTP_LIST_OK,
+	    status,
+	    "Setting flags on an empty list is expected to be successful"
+	);
+
+	// Once with inline entries, once with indexed ones
+	for (round = 0; round < 2; round++)
+	{
+		lhttp_list_add(list, "Set-Cookie", cookies[0]);
+		lhttp_list_add(list, "Via", "1.1 first");
+		lhttp_list_add(list, "set-cookie", cookies[1]);
+		lhttp_list_add(list, "Via", "1.1 second");
+		lhttp_list_add(list, "X-Other", "other");
+
+		// Removing the other key leaves holes, which moves the entries
+		status = lhttp_list_remove(list, "via");
+		TEST_ASSERT_EQUAL_INT_MESSAGE(
+		    LHTTP_LIST_OK,
+		    status,
+		    "Removing a repeated key is expected to be successful"
+		);
+		status = lhttp_list_get(list, "Via", NULL);
+		TEST_ASSERT_EQUAL_INT_MESSAGE(
+		    LHTTP_LIST_ERROR,
+		    status,
+		    "Every value of a removed key is expected to be gone"
+		);
+
+		for (i = 0; list->__count < list->__capacity; i++)
+		{
+			snprintf(key, sizeof(key), "X-Filler-%zu-%zu", round, i);
+			lhttp_list_add(list, key, "filler");
+		}
+
+		lhttp_list_add(list, "SET-COOKIE", cookies[2]);
+		lhttp_list_add(list, "Set-Cookie", cookies[3]);
+
+		status = lhttp_list_get(list, "Set-Cookie", &value);
+		TEST_ASSERT_EQUAL_STRING_MESSAGE(
+		    cookies[0],
+		    value,
+		    "The first value of a repeated key is expected to be returned"
+		);
+
+		status = lhttp_list_match_begin(list, "set-cookie", 10, &match);
+		TEST_ASSERT_EQUAL_INT_MESSAGE(
+		    LHTTP_LIST_OK,
+		    status,
+		    "Matching a present key is expected to be successful"
+		);
+
+		for (i = 0; lhttp_list_match_next(&match, &found, &found_len); i++)
+		{
+			TEST_ASSERT_LESS_THAN_MESSAGE(
+			    4,
+			    i,
+			    "Only the values of the key are expected to be visited"
+			);
+			TEST_ASSERT_EQUAL_STRING_MESSAGE(
+			    cookies[i],
+			    found,
+			    "Values are expected to be visited in arrival order"
+			);
+			TEST_ASSERT_EQUAL_INT_MESSAGE(
+			    strlen(cookies[i]),
+			    found_len,
+			    "Value length is expected to match"
+			);
+		}
+
+		TEST_ASSERT_EQUAL_INT_MESSAGE(
+		    4,
+		    i,
+		    "Every value of the key is expected to be visited"
+		);
+
+		status = lhttp_list_match_begin(list, "Via", 3, &match);
+		TEST_ASSERT_EQUAL_INT_MESSAGE(
+		    LHTTP_LIST_ERROR_KEY_NOT_FOUND,
+		    list->error,
+		    "Matching a missing key is expected to be an error"
+		);
+		TEST_ASSERT_FALSE_MESSAGE(
+		    lhttp_list_match_next(&match, &found, &found_len),
+		    "A missing key is expected to have no values"
+		);
+
+		lhttp_list_remove(list, "Set-Cookie");
+		lhttp_list_remove(list, "X-Other");
+
+		// Move the storage to the heap for the second round
+		for (i = 0; list->__entries == NULL; i++)
+		{
+			snprintf(key, sizeof(key), "X-Spill-%zu", i);
+			lhttp_list_add(list, key, "filler");
+		}
+	}
+
+	TEST_ASSERT_NOT_NULL_MESSAGE(
+	    list->__entries,
+	    "Entries are expected to be on the heap after the second round"
+	);
+
+	// A key repeated across many rehashes keeps all of its values in order
+	for (i = 0; i < 1000; i++)
+	{
+		snprintf(key, sizeof(key), "hop-%zu", i);
+		lhttp_list_add(list, "Via", key);
+		snprintf(key, sizeof(key), "X-Hop-%zu", i);
+		lhttp_list_add(list, key, "filler");
+	}
+
+	lhttp_list_match_begin(list, "via", 3, &match);
+	for (i = 0; lhttp_list_match_next(&match, &found, &found_len); i++)
+	{
+		snprintf(key, sizeof(key), "hop-%zu", i);
+		TEST_ASSERT_EQUAL_STRING_MESSAGE(
+		    key,
+		    found,
+		    "Values are expected to be visited in arrival order"
+		);
+	}
+
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    1000,
+	    i,
+	    "Every value of the key is expected to be visited"
+	);
+
+	TEST_PASS_MESSAGE("MultimapNodes passed");
+}
+
+TEST(TEST_LIST, IterateNodes)
+{
+	lhttp_list_iter_t iter;
+	char key[32], value[32];
+	const char *found_key, *found_value;
+	size_t i, visited, found_len, round;
+
+	status = lhttp_list_iter_begin(list, &iter);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    LHTTP_LIST_OK,
+	    status,
+	    "Iterating an empty list is expected to be successful"
+	);
+	TEST_ASSERT_FALSE_MESSAGE(
+	    lhttp_list_iter_next(&iter, NULL, NULL, NULL, NULL),
+	    "An empty list is expected to have no entries"
+	);
+
+	// Once with inline entries, once with indexed ones
+	for (round = 0; round < 2; round++)
+	{
+		size_t count = round == 0 ? LHTTP_LIST_INLINE_SIZE : 100;
+
+		for (i = 0; i < count; i++)
+		{
+			snprintf(key, sizeof(key), "X-Header-%zu", i);
+			snprintf(value, sizeof(value), "value-%zu", i);
+			lhttp_list_add(list, key, value);
+		}
+
+		// Removed entries leave holes that are expected to be skipped
+		for (i = 0; i < count; i += 3)
+		{
+			snprintf(key, sizeof(key), "X-Header-%zu", i);
+			lhttp_list_remove(list, key);
+		}
+
+		lhttp_list_iter_begin(list, &iter);
+		for (i = 0, visited = 0; visited < count; i++, visited++)
+		{
+			if (!lhttp_list_iter_next(
+			        &iter,
+			        &found_key,
+			        &found_len,
+			        &found_value,
+			        NULL
+			    ))
+			{
+				break;
+			}
+
+			// Every third entry was removed
+			if (i % 3 == 0)
+				i++;
+
+			snprintf(key, sizeof(key), "X-Header-%zu", i);
+			snprintf(value, sizeof(value), "value-%zu", i);
+
+			TEST_ASSERT_EQUAL_STRING_MESSAGE(
+			    key,
+			    found_key,
+			    "Entries are expected to be visited in insertion order"
+			);
+			TEST_ASSERT_EQUAL_size_t_MESSAGE(
+			    strlen(key),
+			    found_len,
+			    "Key length is expected to match"
+			);
+			TEST_ASSERT_EQUAL_STRING_MESSAGE(
+			    value,
+			    found_value,
+			    "Value is expected to be the one of the key"
+			);
+		}
+
+		TEST_ASSERT_EQUAL_size_t_MESSAGE(
+		    list->__size,
+		    visited,
+		    "Every entry is expected to be visited once"
+		);
+
+		lhttp_list_free(list);
+		lhttp_list_init(list);
+	}
+
+	TEST_PASS_MESSAGE("IterateNodes passed");
+}
+
+TEST(TEST_LIST, AddAllNodes)
+{
+	lhttp_list_field_t fields[100];
+	char names[100][32];
+	char *value;
+	size_t i, round;
+
+	for (i = 0; i < 100; i++)
+	{
+		snprintf(names[i], sizeof(names[i]), "X-Header-%zu", i);
+
+		fields[i].name      = names[i];
+		fields[i].name_len  = strlen(names[i]);
+		fields[i].value     = names[i] + 2;
+		fields[i].value_len = strlen(names[i]) - 2;
+	}
+
+	// Once within the inline storage, once past it
+	for (round = 0; round < 2; round++)
+	{
+		size_t count = round == 0 ? LHTTP_LIST_INLINE_SIZE / 2 : 100;
+
+		lhttp_list_add(list, "Host", "example.com");
+
+		status = lhttp_list_add_all(list, fields, count);
+		TEST_ASSERT_EQUAL_INT_MESSAGE(
+		    LHTTP_LIST_OK,
+		    status,
+		    "Adding every field is expected to be successful"
+		);
+		TEST_ASSERT_EQUAL_INT_MESSAGE(
+		    count + 1,
+		    list->__size,
+		    "Every field is expected to be added"
+		);
+
+		for (i = 0; i < count; i++)
+		{
+			status = lhttp_list_get(list, names[i], &value);
+			TEST_ASSERT_EQUAL_STRING_MESSAGE(
+			    names[i] + 2,
+			    value,
+			    "Value is expected to be a NUL-terminated copy"
+			);
+		}
+
+		// A name already in the list rolls the whole array back
+		fields[count - 1].name     = "Host";
+		fields[count - 1].name_len = 4;
+		lhttp_list_remove(list, names[0]);
+
+		status = lhttp_list_add_all(list, fields, count);
+		TEST_ASSERT_EQUAL_INT_MESSAGE(
+		    LHTTP_LIST_ERROR_KEY_EXISTS,
+		    list->error,
+		    "A repeated name is expected to be an error"
+		);
+		TEST_ASSERT_EQUAL_INT_MESSAGE(
+		    count,
+		    list->__size,
+		    "Nothing is expected to be added on failure"
+		);
+		status = lhttp_list_get(list, names[0], NULL);
+		TEST_ASSERT_EQUAL_INT_MESSAGE(
+		    LHTTP_LIST_ERROR,
+		    status,
+		    "Fields before the repeated name are expected to be gone"
+		);
+		status = lhttp_list_get(list, names[1], NULL);
+		TEST_ASSERT_EQUAL_INT_MESSAGE(
+		    LHTTP_LIST_OK,
+		    status,
+		    "Fields added before are expected to stay"
+		);
+
+		fields[count - 1].name     = names[count - 1];
+		fields[count - 1].name_len = strlen(names[count - 1]);
+
+		lhttp_list_free(list);
+		lhttp_list_init(list);
+	}
+
+	// Repeated names are kept in order by a multimap
+	lhttp_list_set_flags(list, LHTTP_LIST_MULTIMAP);
+	fields[1] = fields[0];
+	status    = lhttp_list_add_all(list, fields, 100);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    100,
+	    list->__size,
+	    "Repeated names are expected to be added to a multimap"
+	);
+
+	TEST_PASS_MESSAGE("AddAllNodes passed");
+}
+
+TEST(TEST_LIST, SeededHash)
+{
+	char buffer[64], upper[64], key[32];
+	uint32_t hashes[41];
+	size_t i, j;
+
+	// Every length path of the hash, at every alignment
+	memset(buffer, 0, sizeof(buffer));
+	for (i = 0; i <= 40; i++)
+	{
+		memcpy(buffer, "abcdefghijklmnopqrstuvwxyz0123456789-_.~", i);
+		hashes[i] = __lhttp_hash(42, buffer, i, 0);
+
+		for (j = 1; j < 8; j++)
+		{
+			memmove(buffer + j, buffer + j - 1, i);
+			TEST_ASSERT_EQUAL_UINT32_MESSAGE(
+			    hashes[i],
+			    __lhttp_hash(42, buffer + j, i, 0),
+			    "Hash is expected not to depend on alignment"
+			);
+		}
+		memmove(buffer, buffer + 7, i);
+
+		for (j = 0; j < i; j++)
+		{
+			TEST_ASSERT_NOT_EQUAL_MESSAGE(
+			    hashes[j],
+			    hashes[i],
+			    "Prefixes are expected to hash differently"
+			);
+		}
+
+		for (j = 0; j < i; j++)
+		{
+			upper[j] = buffer[j] >= 'a' && buffer[j] <= 'z' ? buffer[j] - 0x20
+			                                                : buffer[j];
+		}
+
+		TEST_ASSERT_EQUAL_UINT32_MESSAGE(
+		    __lhttp_hash(42, buffer, i, LHTTP_HASH_FOLD),
+		    __lhttp_hash(42, upper, i, LHTTP_HASH_FOLD),
+		    "Folded hash is expected to ignore case"
+		);
+	}
+
+	TEST_ASSERT_NOT_EQUAL_MESSAGE(
+	    __lhttp_hash(1, "Content-Length", 14, 0),
+	    __lhttp_hash(2, "Content-Length", 14, 0),
+	    "Seeds are expected to change the hash"
+	);
+
+	// Lists work the same whatever their seed
+	status = lhttp_list_set_seed(list, 0);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    LHTTP_LIST_OK,
+	    status,
+	    "Setting the seed of an empty list is expected to be successful"
+	);
+
+	for (i = 0; i < 100; i++)
+	{
+		snprintf(key, sizeof(key), "X-Header-%zu", i);
+		lhttp_list_add(list, key, key);
+	}
+
+	for (i = 0; i < 100; i++)
+	{
+		snprintf(key, sizeof(key), "X-Header-%zu", i);
+		status = lhttp_list_get(list, key, NULL);
+		TEST_ASSERT_EQUAL_INT_MESSAGE(
+		    LHTTP_LIST_OK,
+		    status,
+		    "Key is expected to be found"
+		);
+	}
+
+	status = lhttp_list_set_seed(list, 1);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    LHTTP_LIST_ERROR_NOT_EMPTY,
+	    list->error,
+	    "Setting the seed of a list with entries is expected to be an error"
+	);
+
+	TEST_PASS_MESSAGE("SeededHash passed");
+}
+
+TEST(TEST_LIST, FrozenNodes)
+{
+	// Inline, sorted and Eytzinger layouts
+	const size_t sizes[] = {4, 24, 200};
+	const char *cookies[] = {"a=1", "b=2", "c=3"};
+	lhttp_list_match_t match;
+	lhttp_list_iter_t iter;
+	char key[32], expected[32];
+	const char *found;
+	char *value;
+	size_t i, round, found_len;
+
+	for (round = 0; round < 3; round++)
+	{
+		lhttp_list_free(list);
+		lhttp_list_init(list);
+		lhttp_list_set_flags(
+		    list,
+		    LHTTP_LIST_MULTIMAP | LHTTP_LIST_CASE_INSENSITIVE
+		);
+
+		for (i = 0; i < sizes[round]; i++)
+		{
+			snprintf(key, sizeof(key), "X-Header-%zu", i);
+			snprintf(expected, sizeof(expected), "value-%zu", i);
+			lhttp_list_add(list, key, expected);
+
+			if (i % 3 == 0)
+				lhttp_list_add(list, "Set-Cookie", cookies[i / 3 % 3]);
+		}
+
+		// Removed keys leave holes to compact
+		lhttp_list_remove(list, "X-Header-1");
+		lhttp_list_remove(list, "X-Header-2");
+
+		status = lhttp_list_freeze(list);
+		TEST_ASSERT_EQUAL_INT_MESSAGE(
+		    LHTTP_LIST_OK,
+		    status,
+		    "Freezing a list is expected to be successful"
+		);
+		TEST_ASSERT_EQUAL_INT_MESSAGE(
+		    LHTTP_LIST_FROZEN,
+		    list->state,
+		    "List state is expected to be frozen"
+		);
+		TEST_ASSERT_EQUAL_size_t_MESSAGE(
+		    list->__size,
+		    list->__count,
+		    "Frozen entries are expected to be compacted"
+		);
+
+		for (i = 0; i < sizes[round]; i++)
+		{
+			snprintf(key, sizeof(key), "x-header-%zu", i);
+			snprintf(expected, sizeof(expected), "value-%zu", i);
+
+			status = lhttp_list_get(list, key, &value);
+			if (i == 1 || i == 2)
+			{
+				TEST_ASSERT_EQUAL_INT_MESSAGE(
+				    LHTTP_LIST_ERROR_KEY_NOT_FOUND,
+				    list->error,
+				    "Removed keys are expected to stay missing"
+				);
+				continue;
+			}
+
+			TEST_ASSERT_EQUAL_INT_MESSAGE(
+			    LHTTP_LIST_OK,
+			    status,
+			    "Getting a frozen key is expected to be successful"
+			);
+			TEST_ASSERT_EQUAL_STRING_MESSAGE(
+			    expected,
+			    value,
+			    "Frozen value is expected to match"
+			);
+		}
+
+		status = lhttp_list_get(list, "X-Missing", NULL);
+		TEST_ASSERT_EQUAL_INT_MESSAGE(
+		    LHTTP_LIST_ERROR,
+		    status,
+		    "Getting a missing key is expected to be an error"
+		);
+
+		// Repeated keys are still visited in arrival order
+		lhttp_list_match_begin(list, "SET-COOKIE", 10, &match);
+		for (i = 0; lhttp_list_match_next(&match, &found, &found_len); i++)
+		{
+			TEST_ASSERT_EQUAL_STRING_MESSAGE(
+			    cookies[i % 3],
+			    found,
+			    "Frozen values are expected to be visited in arrival order"
+			);
+		}
+
+		TEST_ASSERT_EQUAL_size_t_MESSAGE(
+		    (sizes[round] + 2) / 3,
+		    i,
+		    "Every frozen value of the key is expected to be visited"
+		);
+
+		lhttp_list_iter_begin(list, &iter);
+		for (i = 0; lhttp_list_iter_next(&iter, &found, NULL, NULL, NULL); i++)
+			;
+
+		TEST_ASSERT_EQUAL_size_t_MESSAGE(
+		    list->__size,
+		    i,
+		    "Every frozen entry is expected to be iterated"
+		);
+
+		// Every change is refused
+		status = lhttp_list_add(list, "X-New", "new");
+		TEST_ASSERT_EQUAL_INT_MESSAGE(
+		    LHTTP_LIST_ERROR,
+		    status,
+		    "Adding to a frozen list is expected to fail"
+		);
+		TEST_ASSERT_EQUAL_INT_MESSAGE(
+		    LHTTP_LIST_ERROR_FROZEN,
+		    list->error,
+		    "Adding to a frozen list is expected to be a frozen error"
+		);
+
+		status = lhttp_list_remove(list, "X-Header-0");
+		TEST_ASSERT_EQUAL_INT_MESSAGE(
+		    LHTTP_LIST_ERROR_FROZEN,
+		    list->error,
+		    "Removing from a frozen list is expected to be a frozen error"
+		);
+		status = lhttp_list_get(list, "X-Header-0", NULL);
+		TEST_ASSERT_EQUAL_INT_MESSAGE(
+		    LHTTP_LIST_OK,
+		    status,
+		    "A refused removal is expected to keep the key"
+		);
+
+		status = lhttp_list_set_flags(list, 0);
+		TEST_ASSERT_EQUAL_INT_MESSAGE(
+		    LHTTP_LIST_ERROR_FROZEN,
+		    list->error,
+		    "Setting flags of a frozen list is expected to be a frozen error"
+		);
+
+		status = lhttp_list_freeze(list);
+		TEST_ASSERT_EQUAL_INT_MESSAGE(
+		    LHTTP_LIST_OK,
+		    status,
+		    "Freezing a frozen list is expected to do nothing"
+		);
+	}
+
+	TEST_ASSERT_NOT_NULL_MESSAGE(
+	    list->__slots,
+	    "Large frozen lists are expected to have sorted keys"
+	);
+
+	TEST_PASS_MESSAGE("FrozenNodes passed");
+}
+
+TEST(TEST_LIST, ManyNodes)
+{
+	char key[32], value[32];
+	char *found;
+	size_t i, live;
+
+	// Enough entries to grow the array and the index several times
+	for (i = 0; i < 1000; i++)
+	{
+		snprintf(key, sizeof(key), "X-Header-%zu", i);
+		snprintf(value, sizeof(value), "value-%zu", i);
+
+		status = lhttp_list_add(list, key, value);
+		TEST_ASSERT_EQUAL_INT_MESSAGE(
+		    LHTTP_LIST_OK,
+		    status,
+		    "Adding a node is expected to be successful"
+		);
+	}
+
+	// Remove every even entry, which leaves holes in the storage
+	for (i = 0; i < 1000; i += 2)
+	{
+		snprintf(key, sizeof(key), "X-Header-%zu", i);
+
+		status = lhttp_list_remove(list, key);
+		TEST_ASSERT_EQUAL_INT_MESSAGE(
+		    LHTTP_LIST_OK,
+		    status,
+		    "Removing a node is expected to be successful"
+		);
+	}
+
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    500,
+	    list->__size,
+	    "List size is expected to be 500"
+	);
+
+	for (i = 0; i < 1000; i++)
+	{
+		snprintf(key, sizeof(key), "X-Header-%zu", i);
+		snprintf(value, sizeof(value), "value-%zu", i);
+
+		status = lhttp_list_get(list, key, &found);
+
+		if (i % 2 == 0)
+		{
+			TEST_ASSERT_EQUAL_INT_MESSAGE(
+			    LHTTP_LIST_ERROR,
+			    status,
+			    "Removed node is expected to be gone"
+			);
+		}
+		else
+		{
+			TEST_ASSERT_EQUAL_STRING_MESSAGE(
+			    value,
+			    found,
+			    "Remaining node is expected to keep its value"
+			);
+		}
+	}
+
+	// Adding more reuses the holes, and insertion order is kept
+	for (i = 1000; i < 1600; i++)
+	{
+		snprintf(key, sizeof(key), "X-Header-%zu", i);
+		lhttp_list_add(list, key, "new");
+	}
+
+	for (i = 0, live = 0; i < list->__count; i++)
+	{
+		if (list->__entries[i].__key == NULL)
+			continue;
+
+		snprintf(
+		    key,
+		    sizeof(key),
+		    "X-Header-%zu",
+		    live < 500 ? 2 * live + 1 : live + 500
+		);
+		TEST_ASSERT_EQUAL_STRING_MESSAGE(
+		    key,
+		    list->__entries[i].__key,
+		    "Entries are expected to stay in insertion order"
+		);
+		live++;
+	}
+
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    1100,
+	    live,
+	    "Every node is expected to be stored once"
+	);
+
+	TEST_PASS_MESSAGE("ManyNodes passed");
+}
+
 TEST_GROUP_RUNNER(TEST_LIST)
 {
 	RUN_TEST_CASE(TEST_LIST, InitializeList);
 	RUN_TEST_CASE(TEST_LIST, AddNode);
 	RUN_TEST_CASE(TEST_LIST, GetNode);
 	RUN_TEST_CASE(TEST_LIST, RemoveNode);
+	RUN_TEST_CASE(TEST_LIST, InlineNodes);
+	RUN_TEST_CASE(TEST_LIST, BorrowedNodes);
+	RUN_TEST_CASE(TEST_LIST, CaseInsensitiveNodes);
+	RUN_TEST_CASE(TEST_LIST, MultimapNodes);
+	RUN_TEST_CASE(TEST_LIST, IterateNodes);
+	RUN_TEST_CASE(TEST_LIST, AddAllNodes);
+	RUN_TEST_CASE(TEST_LIST, SeededHash);
+	RUN_TEST_CASE(TEST_LIST, FrozenNodes);
+	RUN_TEST_CASE(TEST_LIST, ManyNodes);
 }
 
 static void RunAllTests(void)
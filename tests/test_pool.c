@@ -0,0 +1,339 @@
+/* Copyright (c) 2024 libhttp. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <lhttp_list.h>
+#include <lhttp_pool.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <unity/unity.h>
+#include <unity/unity_fixture.h>
+
+TEST_GROUP(TEST_POOL);
+
+#define BATCH 8
+
+lhttp_pool_t pool;
+lhttp_pool_cache_t cache;
+
+// Run before each test
+TEST_SETUP(TEST_POOL)
+{
+	lhttp_pool_init(&pool, 40, BATCH, NULL);
+	lhttp_pool_cache_init(&cache, &pool);
+}
+
+// Run after each test
+TEST_TEAR_DOWN(TEST_POOL)
+{
+	lhttp_pool_cache_free(&cache);
+	lhttp_pool_free(&pool);
+}
+
+static size_t count_slabs(void)
+{
+	struct __lhttp_pool_slab_s *slab;
+	size_t n = 0;
+
+	for (slab = pool.__slabs; slab != NULL; slab = slab->__next)
+		n++;
+
+	return n;
+}
+
+TEST(TEST_POOL, AllocateBlocks)
+{
+	char *blocks[3 * BATCH];
+	char *again;
+	size_t i;
+
+	TEST_ASSERT_EQUAL_size_t_MESSAGE(
+	    48,
+	    pool.__block_size,
+	    "Block size is expected to be rounded up to the alignment"
+	);
+
+	for (i = 0; i < 3 * BATCH; i++)
+	{
+		blocks[i] = lhttp_pool_cache_alloc(&cache);
+
+		TEST_ASSERT_NOT_NULL_MESSAGE(blocks[i], "Block is expected to exist");
+		TEST_ASSERT_EQUAL_size_t_MESSAGE(
+		    0,
+		    (uintptr_t)blocks[i] % LHTTP_POOL_ALIGN,
+		    "Block is expected to be aligned"
+		);
+		memset(blocks[i], (int)i, pool.__block_size);
+	}
+
+	TEST_ASSERT_EQUAL_size_t_MESSAGE(
+	    3,
+	    count_slabs(),
+	    "One slab is expected per batch of blocks"
+	);
+
+	for (i = 0; i < 3 * BATCH; i++)
+	{
+		TEST_ASSERT_EACH_EQUAL_CHAR_MESSAGE(
+		    (char)i,
+		    blocks[i],
+		    pool.__block_size,
+		    "Blocks are expected not to overlap"
+		);
+	}
+
+	// The last released block is the first one handed out again
+	lhttp_pool_cache_release(&cache, blocks[5]);
+	again = lhttp_pool_cache_alloc(&cache);
+	TEST_ASSERT_EQUAL_PTR_MESSAGE(
+	    blocks[5],
+	    again,
+	    "Released block is expected to be reused first"
+	);
+
+	for (i = 0; i < 3 * BATCH; i++)
+		lhttp_pool_cache_release(&cache, blocks[i]);
+
+	TEST_PASS_MESSAGE("AllocateBlocks passed");
+}
+
+TEST(TEST_POOL, BatchedReturns)
+{
+	lhttp_pool_cache_t other;
+	void *blocks[4 * BATCH];
+	size_t i;
+
+	lhttp_pool_cache_init(&other, &pool);
+
+	for (i = 0; i < 4 * BATCH; i++)
+		blocks[i] = lhttp_pool_cache_alloc(&cache);
+
+	// Blocks allocated by one cache are freed through another one, which
+	// keeps at most two batches before handing one to the pool
+	for (i = 0; i < 4 * BATCH; i++)
+	{
+		lhttp_pool_cache_release(&other, blocks[i]);
+
+		TEST_ASSERT_LESS_THAN_size_t_MESSAGE(
+		    2 * BATCH,
+		    other.__count,
+		    "Cache is expected to give batches back to the pool"
+		);
+	}
+
+	TEST_ASSERT_NOT_NULL_MESSAGE(
+	    pool.__full,
+	    "Full batches are expected to be back in the pool"
+	);
+
+	// The returned batches are reused instead of new slabs
+	for (i = 0; i < 2 * BATCH; i++)
+		blocks[i] = lhttp_pool_cache_alloc(&cache);
+
+	TEST_ASSERT_EQUAL_size_t_MESSAGE(
+	    4,
+	    count_slabs(),
+	    "Returned batches are expected to be reused"
+	);
+
+	for (i = 0; i < 2 * BATCH; i++)
+		lhttp_pool_cache_release(&cache, blocks[i]);
+
+	// A released cache gives partial batches back as loose blocks
+	lhttp_pool_cache_release(&other, lhttp_pool_cache_alloc(&other));
+	lhttp_pool_cache_free(&other);
+	TEST_ASSERT_EQUAL_size_t_MESSAGE(
+	    0,
+	    other.__count,
+	    "Released cache is expected to be empty"
+	);
+
+	TEST_PASS_MESSAGE("BatchedReturns passed");
+}
+
+TEST(TEST_POOL, PoolAllocator)
+{
+	const lhttp_allocator_t *allocator = lhttp_pool_cache_allocator(&cache);
+	lhttp_list_t headers;
+	char key[32], value[128];
+	char *block, *grown, *found;
+	size_t i;
+	int s;
+
+	// Resizing within a block keeps it, resizing past it moves the data
+	block = allocator->malloc_fn(allocator->ctx, 8);
+	memcpy(block, "abcdefg", 8);
+	grown = allocator->realloc_fn(allocator->ctx, block, 8, 32);
+	TEST_ASSERT_EQUAL_PTR_MESSAGE(
+	    block,
+	    grown,
+	    "Block is expected to be resized in place"
+	);
+	grown = allocator->realloc_fn(allocator->ctx, grown, 32, 4096);
+	TEST_ASSERT_EQUAL_STRING_MESSAGE(
+	    "abcdefg",
+	    grown,
+	    "Moved block is expected to keep its content"
+	);
+	allocator->free_fn(allocator->ctx, grown, 4096);
+
+	s = lhttp_list_init_with_allocator(&headers, allocator);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    LHTTP_LIST_OK,
+	    s,
+	    "List is expected to be initialized"
+	);
+
+	// Short entries fit in blocks, long ones and the storage do not
+	for (i = 0; i < 100; i++)
+	{
+		snprintf(key, sizeof(key), "X-Header-%zu", i);
+		memset(value, 'v', sizeof(value) - 1);
+		value[i % 2 == 0 ? 8 : sizeof(value) - 1] = '\0';
+
+		s = lhttp_list_add(&headers, key, value);
+		TEST_ASSERT_EQUAL_INT_MESSAGE(
+		    LHTTP_LIST_OK,
+		    s,
+		    "Adding a node is expected to be successful"
+		);
+	}
+
+	for (i = 0; i < 100; i++)
+	{
+		snprintf(key, sizeof(key), "X-Header-%zu", i);
+
+		s = lhttp_list_get(&headers, key, &found);
+		TEST_ASSERT_EQUAL_size_t_MESSAGE(
+		    i % 2 == 0 ? 8 : sizeof(value) - 1,
+		    strlen(found),
+		    "Value is expected to be intact"
+		);
+	}
+
+	lhttp_list_free(&headers);
+
+	TEST_PASS_MESSAGE("PoolAllocator passed");
+}
+
+/* Each worker builds lists through its own cache while the others do the
+ * same, then reads the lists of its neighbour */
+#define WORKERS 4
+
+struct worker
+{
+	lhttp_list_t lists[2];
+	pthread_barrier_t *barrier;
+	struct worker *neighbour;
+	int failures;
+};
+
+static void *work(void *arg)
+{
+	struct worker *w = arg;
+	lhttp_pool_cache_t local;
+	char key[32];
+	size_t round, i;
+
+	lhttp_pool_cache_init(&local, &pool);
+
+	for (round = 0; round < 2; round++)
+	{
+		lhttp_list_init_with_allocator(
+		    &w->lists[round],
+		    lhttp_pool_cache_allocator(&local)
+		);
+
+		for (i = 0; i < 200; i++)
+		{
+			snprintf(key, sizeof(key), "X-Header-%zu", i);
+			if (lhttp_list_add(&w->lists[round], key, "value") != 0)
+				w->failures++;
+		}
+	}
+
+	pthread_barrier_wait(w->barrier);
+
+	// Free one list while the neighbour reads the other one
+	lhttp_list_free(&w->lists[0]);
+
+	for (i = 0; i < 200; i++)
+	{
+		snprintf(key, sizeof(key), "X-Header-%zu", i);
+		if (lhttp_list_get(&w->neighbour->lists[1], key, NULL) != 0)
+			w->failures++;
+	}
+
+	pthread_barrier_wait(w->barrier);
+
+	lhttp_list_free(&w->lists[1]);
+	lhttp_pool_cache_free(&local);
+
+	return NULL;
+}
+
+TEST(TEST_POOL, ThreadedCaches)
+{
+	struct worker workers[WORKERS];
+	pthread_t threads[WORKERS];
+	pthread_barrier_t barrier;
+	size_t i;
+
+	pthread_barrier_init(&barrier, NULL, WORKERS);
+
+	for (i = 0; i < WORKERS; i++)
+	{
+		workers[i].barrier   = &barrier;
+		workers[i].neighbour = &workers[(i + 1) % WORKERS];
+		workers[i].failures  = 0;
+	}
+
+	for (i = 0; i < WORKERS; i++)
+		pthread_create(&threads[i], NULL, work, &workers[i]);
+
+	for (i = 0; i < WORKERS; i++)
+	{
+		pthread_join(threads[i], NULL);
+
+		TEST_ASSERT_EQUAL_INT_MESSAGE(
+		    0,
+		    workers[i].failures,
+		    "Lists built in parallel are expected to stay intact"
+		);
+	}
+
+	pthread_barrier_destroy(&barrier);
+
+	TEST_PASS_MESSAGE("ThreadedCaches passed");
+}
+
+TEST_GROUP_RUNNER(TEST_POOL)
+{
+	RUN_TEST_CASE(TEST_POOL, AllocateBlocks);
+	RUN_TEST_CASE(TEST_POOL, BatchedReturns);
+	RUN_TEST_CASE(TEST_POOL, PoolAllocator);
+	RUN_TEST_CASE(TEST_POOL, ThreadedCaches);
+}
+
+static void RunAllTests(void)
+{
+	RUN_TEST_GROUP(TEST_POOL);
+}
+
+int main(int argc, const char *argv[])
+{
+	return UnityMain(argc, argv, RunAllTests);
+}
@@ -14,6 +14,7 @@
  */
 
 #include <lhttp_request.h>
+#include <stdio.h>
 #include <unity/unity.h>
 #include <unity/unity_fixture.h>
 
@@ -183,12 +184,1226 @@ TEST(TEST_REQUEST, ParseRequest)
 	TEST_PASS_MESSAGE("Parse request test passed");
 }
 
+TEST(TEST_REQUEST, ParseRequestIncrementally)
+{
+	lhttp_request_t fragmented;
+	size_t len = strlen(get_http_request);
+	size_t i;
+	int s;
+
+	s = lhttp_request_init(&fragmented, len);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    0,
+	    s,
+	    "Request initialization is expected to be successful"
+	);
+
+	// Feed the message one byte at a time, like the worst possible socket
+	for (i = 0; i < len - 1; i++)
+	{
+		s = lhttp_request_parse(&fragmented, get_http_request + i, 1);
+
+		TEST_ASSERT_EQUAL_INT_MESSAGE(
+		    LHTTP_REQUEST_PARSING_ONGOING,
+		    s,
+		    "Parsing a partial message is expected to ask for more data"
+		);
+	}
+
+	s = lhttp_request_parse(&fragmented, get_http_request + i, 1);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    0,
+	    s,
+	    "Parsing the last byte is expected to complete the request"
+	);
+
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    LHTTP_REQUEST_PARSING_DONE,
+	    fragmented.status,
+	    "Request status is expected to be done"
+	);
+
+	// The markers must match the ones of a request parsed in one go
+	TEST_ASSERT_EQUAL_STRING_LEN_MESSAGE(
+	    "GET",
+	    fragmented.__method_start,
+	    fragmented.__method_end - fragmented.__method_start,
+	    "Method is expected to be equal to 'GET'"
+	);
+
+	TEST_ASSERT_EQUAL_STRING_LEN_MESSAGE(
+	    "/",
+	    fragmented.__uri_start,
+	    fragmented.__uri_end - fragmented.__uri_start,
+	    "URI is expected to be equal to '/'"
+	);
+
+	TEST_ASSERT_EQUAL_STRING_LEN_MESSAGE(
+	    "HTTP/1.1",
+	    fragmented.__version_start,
+	    fragmented.__version_end - fragmented.__version_start,
+	    "Version is expected to be equal to 'HTTP/1.1'"
+	);
+
+	TEST_ASSERT_EQUAL_PTR_MESSAGE(
+	    fragmented.__buf + len - 2,
+	    fragmented.__headers_end,
+	    "Header section is expected to end at the final CRLF"
+	);
+
+	lhttp_request_free(&fragmented);
+
+	TEST_PASS_MESSAGE("Parse request incrementally test passed");
+}
+
+TEST(TEST_REQUEST, ParseRequestTooLarge)
+{
+	lhttp_request_t small;
+	int s;
+
+	// The buffer cannot even hold the request line
+	s = lhttp_request_init(&small, 8);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    0,
+	    s,
+	    "Request initialization is expected to be successful"
+	);
+
+	s = lhttp_request_parse(
+	    &small,
+	    get_http_request,
+	    strlen(get_http_request)
+	);
+
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    LHTTP_REQUEST_ERROR,
+	    s,
+	    "Parsing a message larger than the buffer is expected to fail"
+	);
+
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    LHTTP_REQUEST_ERROR_TOO_LARGE | LHTTP_REQUEST_REQUEST_LINE,
+	    small.error,
+	    "Error is expected to be a request line that is too large"
+	);
+
+	lhttp_request_free(&small);
+
+	TEST_PASS_MESSAGE("Parse request too large test passed");
+}
+
+TEST(TEST_REQUEST, ParseRequestBorrowed)
+{
+	lhttp_request_t borrowed;
+	size_t len  = strlen(get_http_request);
+	size_t half = len / 2;
+	int s;
+
+	s = lhttp_request_init_borrowed(&borrowed, len);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    0,
+	    s,
+	    "Request initialization is expected to be successful"
+	);
+
+	// Nothing is allocated for a borrowed request
+	TEST_ASSERT_NULL_MESSAGE(
+	    borrowed.__buf,
+	    "Buffer is expected to be NULL for a borrowed request"
+	);
+
+	s = lhttp_request_parse(&borrowed, get_http_request, half);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    LHTTP_REQUEST_PARSING_ONGOING,
+	    s,
+	    "Parsing a partial message is expected to ask for more data"
+	);
+
+	// A chunk that does not follow the previous one cannot be borrowed
+	s = lhttp_request_parse(&borrowed, get_http_request, len);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    LHTTP_REQUEST_ERROR,
+	    s,
+	    "Parsing a non-contiguous chunk is expected to fail"
+	);
+
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    LHTTP_REQUEST_PARSING_ONGOING,
+	    borrowed.status,
+	    "Rejecting a chunk is expected to leave the request untouched"
+	);
+
+	s = lhttp_request_parse(&borrowed, get_http_request + half, len - half);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    0,
+	    s,
+	    "Parsing the rest of the message is expected to be successful"
+	);
+
+	// The markers point straight into the caller's buffer
+	TEST_ASSERT_EQUAL_PTR_MESSAGE(
+	    get_http_request,
+	    borrowed.__method_start,
+	    "Method is expected to start in the caller's buffer"
+	);
+
+	TEST_ASSERT_EQUAL_STRING_LEN_MESSAGE(
+	    "/",
+	    borrowed.__uri_start,
+	    borrowed.__uri_end - borrowed.__uri_start,
+	    "URI is expected to be equal to '/'"
+	);
+
+	TEST_ASSERT_EQUAL_PTR_MESSAGE(
+	    get_http_request + len - 2,
+	    borrowed.__headers_end,
+	    "Header section is expected to end at the final CRLF"
+	);
+
+	lhttp_request_free(&borrowed);
+
+	TEST_PASS_MESSAGE("Parse borrowed request test passed");
+}
+
+TEST(TEST_REQUEST, ParseHeaders)
+{
+	lhttp_request_t headers;
+	const char *message = "GET / HTTP/1.1\r\n"
+	                      "Host:localhost:8080\r\n"
+	                      "User-Agent: \t curl/7.68.0 \t \r\n"
+	                      "X-Empty: \r\n"
+	                      "Accept: */*\r\n"
+	                      "\r\n";
+	const char *expected[][2] = {
+	    {"Host",       "localhost:8080"},
+	    {"User-Agent", "curl/7.68.0"   },
+	    {"X-Empty",    ""              },
+	    {"Accept",     "*/*"           },
+	};
+	const char *name, *value;
+	size_t name_len, value_len;
+	size_t i;
+	int s;
+
+	lhttp_request_init_borrowed(&headers, strlen(message));
+
+	s = lhttp_request_parse(&headers, message, strlen(message));
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    0,
+	    s,
+	    "Request parsing is expected to be successful"
+	);
+
+	TEST_ASSERT_EQUAL_UINT_MESSAGE(
+	    4,
+	    lhttp_request_header_count(&headers),
+	    "Request is expected to have 4 header fields"
+	);
+
+	// Names and values are sliced without the surrounding whitespace
+	for (i = 0; i < 4; i++)
+	{
+		s = lhttp_request_header_at(
+		    &headers,
+		    i,
+		    &name,
+		    &name_len,
+		    &value,
+		    &value_len
+		);
+
+		TEST_ASSERT_EQUAL_INT_MESSAGE(0, s, "Header field is expected");
+
+		TEST_ASSERT_EQUAL_UINT_MESSAGE(
+		    strlen(expected[i][0]),
+		    name_len,
+		    "Header name length is expected to match"
+		);
+		TEST_ASSERT_EQUAL_STRING_LEN_MESSAGE(
+		    expected[i][0],
+		    name,
+		    name_len,
+		    "Header name is expected to match"
+		);
+
+		TEST_ASSERT_EQUAL_UINT_MESSAGE(
+		    strlen(expected[i][1]),
+		    value_len,
+		    "Header value length is expected to match"
+		);
+		TEST_ASSERT_EQUAL_STRING_LEN_MESSAGE(
+		    expected[i][1],
+		    value,
+		    value_len,
+		    "Header value is expected to match"
+		);
+	}
+
+	s = lhttp_request_header_at(
+	    &headers,
+	    4,
+	    &name,
+	    &name_len,
+	    &value,
+	    &value_len
+	);
+
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    LHTTP_REQUEST_ERROR,
+	    s,
+	    "Getting a header field out of range is expected to fail"
+	);
+
+	lhttp_request_free(&headers);
+
+	TEST_PASS_MESSAGE("Parse headers test passed");
+}
+
+TEST(TEST_REQUEST, ParseInvalidHeaders)
+{
+	lhttp_request_t invalid;
+	const char *messages[] = {
+	    "GET / HTTP/1.1\r\nHost : localhost\r\n\r\n",
+	    "GET / HTTP/1.1\r\n: localhost\r\n\r\n",
+	    "GET / HTTP/1.1\r\nHost\r\n\r\n",
+	    "GET / HTTP/1.1\r\nHost: localhost\n\r\n",
+	    "GET / HTTP/1.1\r\nHost: localhost\r\n folded\r\n\r\n",
+	};
+	size_t i;
+	int s;
+
+	for (i = 0; i < sizeof(messages) / sizeof(messages[0]); i++)
+	{
+		lhttp_request_init_borrowed(&invalid, strlen(messages[i]));
+
+		s = lhttp_request_parse(&invalid, messages[i], strlen(messages[i]));
+
+		TEST_ASSERT_EQUAL_INT_MESSAGE(
+		    LHTTP_REQUEST_ERROR,
+		    s,
+		    "Parsing a malformed header field is expected to fail"
+		);
+
+		TEST_ASSERT_EQUAL_INT_MESSAGE(
+		    LHTTP_REQUEST_ERROR_HEADERS,
+		    invalid.error,
+		    "Error is expected to be in the header section"
+		);
+
+		lhttp_request_free(&invalid);
+	}
+
+	TEST_PASS_MESSAGE("Parse invalid headers test passed");
+}
+
+TEST(TEST_REQUEST, HeaderIds)
+{
+	// Case of the name does not matter
+	TEST_ASSERT_EQUAL_INT(LHTTP_HEADER_HOST, lhttp_header_id("Host", 4));
+	TEST_ASSERT_EQUAL_INT(LHTTP_HEADER_HOST, lhttp_header_id("hOST", 4));
+	TEST_ASSERT_EQUAL_INT(LHTTP_HEADER_TE, lhttp_header_id("TE", 2));
+	TEST_ASSERT_EQUAL_INT(
+	    LHTTP_HEADER_CONTENT_LENGTH,
+	    lhttp_header_id("Content-Length", 14)
+	);
+	TEST_ASSERT_EQUAL_INT(
+	    LHTTP_HEADER_X_FORWARDED_PROTO,
+	    lhttp_header_id("X-Forwarded-Proto", 17)
+	);
+
+	// Names that only share the hash or a prefix with a known name
+	TEST_ASSERT_EQUAL_INT(LHTTP_HEADER_UNKNOWN, lhttp_header_id("Hosts", 5));
+	TEST_ASSERT_EQUAL_INT(LHTTP_HEADER_UNKNOWN, lhttp_header_id("Hxst", 4));
+	TEST_ASSERT_EQUAL_INT(LHTTP_HEADER_UNKNOWN, lhttp_header_id("X-Foo", 5));
+	TEST_ASSERT_EQUAL_INT(LHTTP_HEADER_UNKNOWN, lhttp_header_id("", 0));
+
+	TEST_PASS_MESSAGE("Header IDs test passed");
+}
+
+TEST(TEST_REQUEST, GetKnownHeaders)
+{
+	lhttp_request_t known;
+	const char *message = "POST /upload HTTP/1.1\r\n"
+	                      "host: example.com\r\n"
+	                      "Cookie: a=1\r\n"
+	                      "Content-Length: 4\r\n"
+	                      "Cookie: b=2\r\n"
+	                      "\r\n"
+	                      "body";
+	const char *value;
+	size_t value_len;
+	int s;
+
+	lhttp_request_init_borrowed(&known, strlen(message));
+
+	s = lhttp_request_parse(&known, message, strlen(message));
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    0,
+	    s,
+	    "Request parsing is expected to be successful"
+	);
+
+	s = lhttp_request_header_get(&known, LHTTP_HEADER_HOST, &value, &value_len);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(0, s, "Host is expected to be found");
+	TEST_ASSERT_EQUAL_STRING_LEN_MESSAGE(
+	    "example.com",
+	    value,
+	    value_len,
+	    "Host is expected to be equal to 'example.com'"
+	);
+
+	s = lhttp_request_header_get(
+	    &known,
+	    LHTTP_HEADER_CONTENT_LENGTH,
+	    &value,
+	    &value_len
+	);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(0, s, "Content-Length is expected");
+	TEST_ASSERT_EQUAL_STRING_LEN_MESSAGE(
+	    "4",
+	    value,
+	    value_len,
+	    "Content-Length is expected to be equal to '4'"
+	);
+
+	// Repeated fields resolve to their first occurrence
+	s = lhttp_request_header_get(
+	    &known,
+	    LHTTP_HEADER_COOKIE,
+	    &value,
+	    &value_len
+	);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(0, s, "Cookie is expected to be found");
+	TEST_ASSERT_EQUAL_STRING_LEN_MESSAGE(
+	    "a=1",
+	    value,
+	    value_len,
+	    "Cookie is expected to be equal to 'a=1'"
+	);
+
+	s = lhttp_request_header_get(
+	    &known,
+	    LHTTP_HEADER_ACCEPT,
+	    &value,
+	    &value_len
+	);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    LHTTP_REQUEST_ERROR,
+	    s,
+	    "Accept is expected to be missing"
+	);
+
+	lhttp_request_free(&known);
+
+	TEST_PASS_MESSAGE("Get known headers test passed");
+}
+
+TEST(TEST_REQUEST, HeaderList)
+{
+	lhttp_request_t parsed;
+	lhttp_list_t headers;
+	lhttp_list_match_t match;
+	const char *message = "GET / HTTP/1.1\r\n"
+	                      "Host: example.com\r\n"
+	                      "Cookie: a=1\r\n"
+	                      "Accept: */*\r\n"
+	                      "Cookie: b=2\r\n"
+	                      "\r\n";
+	const char *value;
+	char *host;
+	size_t value_len;
+	int s;
+
+	lhttp_request_init(&parsed, 1024);
+	s = lhttp_request_parse(&parsed, message, strlen(message));
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    0,
+	    s,
+	    "Request parsing is expected to be successful"
+	);
+
+	// A plain list rejects the repeated Cookie field, and stays empty
+	lhttp_list_init(&headers);
+	s = lhttp_request_header_list(&parsed, &headers);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    LHTTP_LIST_ERROR_KEY_EXISTS,
+	    headers.error,
+	    "Repeated fields are expected to need a multimap list"
+	);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    0,
+	    headers.__size,
+	    "Nothing is expected to be added on failure"
+	);
+
+	lhttp_list_set_flags(
+	    &headers,
+	    LHTTP_LIST_CASE_INSENSITIVE | LHTTP_LIST_MULTIMAP
+	);
+	s = lhttp_request_header_list(&parsed, &headers);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    0,
+	    s,
+	    "Copying the header fields is expected to be successful"
+	);
+
+	// The copies outlive the request
+	lhttp_request_reset(&parsed);
+
+	s = lhttp_list_get(&headers, "host", &host);
+	TEST_ASSERT_EQUAL_STRING_MESSAGE(
+	    "example.com",
+	    host,
+	    "Host is expected to be equal to 'example.com'"
+	);
+
+	lhttp_list_match_begin(&headers, "Cookie", 6, &match);
+	lhttp_list_match_next(&match, &value, &value_len);
+	TEST_ASSERT_EQUAL_STRING_MESSAGE(
+	    "a=1",
+	    value,
+	    "First cookie is expected to be equal to 'a=1'"
+	);
+	lhttp_list_match_next(&match, &value, &value_len);
+	TEST_ASSERT_EQUAL_STRING_MESSAGE(
+	    "b=2",
+	    value,
+	    "Second cookie is expected to be equal to 'b=2'"
+	);
+
+	lhttp_list_free(&headers);
+	lhttp_request_free(&parsed);
+
+	TEST_PASS_MESSAGE("Header list test passed");
+}
+
+TEST(TEST_REQUEST, ParsePipelinedRequests)
+{
+	lhttp_request_t pipelined;
+	char stream[1024];
+	const char *p, *end;
+	size_t len = 0, consumed;
+	int i, s;
+
+	// Sixteen requests in a single read, as a pipelining client sends them
+	for (i = 0; i < 16; i++)
+	{
+		len += snprintf(
+		    stream + len,
+		    sizeof(stream) - len,
+		    "GET /%d HTTP/1.1\r\nHost: example.com\r\n\r\n",
+		    i
+		);
+	}
+
+	p   = stream;
+	end = stream + len;
+
+	for (i = 0; i < 16; i++)
+	{
+		char uri[8];
+
+		lhttp_request_init_borrowed(&pipelined, end - p);
+
+		s = lhttp_request_parse_stream(&pipelined, p, end - p, &consumed);
+		TEST_ASSERT_EQUAL_INT_MESSAGE(
+		    0,
+		    s,
+		    "Each pipelined request is expected to parse successfully"
+		);
+
+		snprintf(uri, sizeof(uri), "/%d", i);
+		TEST_ASSERT_EQUAL_STRING_LEN_MESSAGE(
+		    uri,
+		    pipelined.__uri_start,
+		    pipelined.__uri_end - pipelined.__uri_start,
+		    "Pipelined requests are expected to be parsed in order"
+		);
+
+		TEST_ASSERT_EQUAL_PTR_MESSAGE(
+		    pipelined.__body_end,
+		    p + consumed,
+		    "Consumed bytes are expected to end with the message"
+		);
+
+		lhttp_request_free(&pipelined);
+		p += consumed;
+	}
+
+	TEST_ASSERT_EQUAL_PTR_MESSAGE(
+	    end,
+	    p,
+	    "The whole stream is expected to be consumed"
+	);
+
+	// In copy mode, the request keeps only its own message
+	lhttp_request_init(&pipelined, 128);
+	s = lhttp_request_parse_stream(&pipelined, stream, len, &consumed);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(0, s, "Parsing is expected to succeed");
+	TEST_ASSERT_EQUAL_STRING_MESSAGE(
+	    "GET /0 HTTP/1.1\r\nHost: example.com\r\n\r\n",
+	    pipelined.__buf,
+	    "Buffer is expected to hold the first message only"
+	);
+	lhttp_request_free(&pipelined);
+
+	TEST_PASS_MESSAGE("Parse pipelined requests test passed");
+}
+
+TEST(TEST_REQUEST, ParseRequestBody)
+{
+	lhttp_request_t body;
+	const char *message = "POST /form HTTP/1.1\r\n"
+	                      "Content-Length: 11\r\n"
+	                      "\r\n"
+	                      "hello world"
+	                      "GET / HTTP/1.1\r\n\r\n";
+	size_t len          = strlen(message);
+	size_t consumed, i;
+	int s;
+
+	// Feed the message one byte at a time
+	lhttp_request_init(&body, len);
+
+	for (i = 0, s = LHTTP_REQUEST_PARSING_ONGOING; i < len; i++)
+	{
+		s = lhttp_request_parse_stream(&body, message + i, 1, &consumed);
+		if (s != LHTTP_REQUEST_PARSING_ONGOING)
+			break;
+
+		TEST_ASSERT_EQUAL_size_t_MESSAGE(
+		    1,
+		    consumed,
+		    "An incomplete message is expected to consume the whole chunk"
+		);
+	}
+
+	TEST_ASSERT_EQUAL_INT_MESSAGE(0, s, "Parsing is expected to succeed");
+	TEST_ASSERT_EQUAL_size_t_MESSAGE(
+	    len - strlen("GET / HTTP/1.1\r\n\r\n") - 1,
+	    i,
+	    "Message is expected to complete on the last byte of its body"
+	);
+	TEST_ASSERT_EQUAL_STRING_LEN_MESSAGE(
+	    "hello world",
+	    body.__body_start,
+	    body.__body_end - body.__body_start,
+	    "Body is expected to be equal to 'hello world'"
+	);
+	lhttp_request_free(&body);
+
+	// A body that can never fit fails as soon as its length is known
+	lhttp_request_init(&body, 48);
+	s = lhttp_request_parse(&body, message, len);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    LHTTP_REQUEST_ERROR,
+	    s,
+	    "Parsing a body larger than the buffer is expected to fail"
+	);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    LHTTP_REQUEST_ERROR_TOO_LARGE | LHTTP_REQUEST_ERROR_BODY,
+	    body.error,
+	    "Error is expected to be a too large body"
+	);
+	lhttp_request_free(&body);
+
+	TEST_PASS_MESSAGE("Parse request body test passed");
+}
+
+TEST(TEST_REQUEST, ParseChunkedBody)
+{
+	lhttp_request_t chunked;
+	const char *message = "POST /upload HTTP/1.1\r\n"
+	                      "Transfer-Encoding: gzip, Chunked\r\n"
+	                      "\r\n"
+	                      "5;name=value\r\nhello\r\n"
+	                      "a\r\n0123456789\r\n"
+	                      "0\r\n"
+	                      "Trailer: yes\r\n"
+	                      "\r\n";
+	const char *invalid[] = {
+	    // Content-Length and Transfer-Encoding together
+	    "POST / HTTP/1.1\r\nContent-Length: 3\r\n"
+	    "Transfer-Encoding: chunked\r\n\r\n0\r\n\r\n",
+	    // Final coding that is not chunked
+	    "POST / HTTP/1.1\r\nTransfer-Encoding: chunked, gzip\r\n\r\n",
+	    // Conflicting lengths
+	    "POST / HTTP/1.1\r\nContent-Length: 1\r\nContent-Length: 2\r\n\r\n",
+	    // Not a number
+	    "POST / HTTP/1.1\r\nContent-Length: +1\r\n\r\nx",
+	    // Chunk data longer than its size
+	    "POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n"
+	    "1\r\nab\r\n0\r\n\r\n",
+	};
+	size_t len = strlen(message);
+	size_t consumed, i;
+	int s;
+
+	for (i = 1; i < len; i++)
+	{
+		// Every split point is expected to give the same result
+		lhttp_request_init_borrowed(&chunked, len);
+
+		s = lhttp_request_parse_stream(&chunked, message, i, &consumed);
+		TEST_ASSERT_EQUAL_INT_MESSAGE(
+		    LHTTP_REQUEST_PARSING_ONGOING,
+		    s,
+		    "Parsing a partial chunked message is expected to ask for more"
+		);
+
+		s = lhttp_request_parse_stream(
+		    &chunked,
+		    message + i,
+		    len - i,
+		    &consumed
+		);
+		TEST_ASSERT_EQUAL_INT_MESSAGE(0, s, "Parsing is expected to succeed");
+		TEST_ASSERT_EQUAL_size_t_MESSAGE(
+		    len - i,
+		    consumed,
+		    "The rest of the message is expected to be consumed"
+		);
+		TEST_ASSERT_EQUAL_PTR_MESSAGE(
+		    message + len,
+		    chunked.__body_end,
+		    "Body is expected to span the whole chunked encoding"
+		);
+
+		lhttp_request_free(&chunked);
+	}
+
+	// Repeating the same Content-Length is fine
+	lhttp_request_init(&chunked, 256);
+	s = lhttp_request_parse(
+	    &chunked,
+	    "POST / HTTP/1.1\r\nContent-Length: 1\r\nContent-Length: 1\r\n\r\nx",
+	    58
+	);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    0,
+	    s,
+	    "Repeated equal lengths are expected to be accepted"
+	);
+	lhttp_request_free(&chunked);
+
+	for (i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++)
+	{
+		lhttp_request_init(&chunked, 256);
+
+		s = lhttp_request_parse(&chunked, invalid[i], strlen(invalid[i]));
+		TEST_ASSERT_EQUAL_INT_MESSAGE(
+		    LHTTP_REQUEST_ERROR,
+		    s,
+		    "Parsing an ambiguous body is expected to fail"
+		);
+
+		lhttp_request_free(&chunked);
+	}
+
+	TEST_PASS_MESSAGE("Parse chunked body test passed");
+}
+
+TEST(TEST_REQUEST, ResetRequest)
+{
+	lhttp_request_t reused;
+	const char *second = "POST /second HTTP/1.0\r\nHost: b\r\n\r\n";
+	char *buf;
+	int s;
+
+	lhttp_request_init(&reused, 128);
+	buf = reused.__buf;
+
+	s = lhttp_request_parse(
+	    &reused,
+	    get_http_request,
+	    strlen(get_http_request)
+	);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(0, s, "Parsing is expected to succeed");
+
+	s = lhttp_request_reset(&reused);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(0, s, "Reset is expected to succeed");
+
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    LHTTP_REQUEST_PARSING_INITIALIZED,
+	    reused.status,
+	    "Request status is expected to be initialized for parsing"
+	);
+	TEST_ASSERT_EQUAL_PTR_MESSAGE(
+	    buf,
+	    reused.__buf,
+	    "Buffer is expected to be kept across a reset"
+	);
+	TEST_ASSERT_NULL_MESSAGE(
+	    reused.__method_start,
+	    "Beginning marker of method is expected to be NULL"
+	);
+	TEST_ASSERT_EQUAL_size_t_MESSAGE(
+	    0,
+	    lhttp_request_header_count(&reused),
+	    "Header index is expected to be empty"
+	);
+
+	s = lhttp_request_parse(&reused, second, strlen(second));
+	TEST_ASSERT_EQUAL_INT_MESSAGE(0, s, "Parsing is expected to succeed");
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    LHTTP_METHOD_POST,
+	    reused.method,
+	    "Method is expected to be the one of the second message"
+	);
+	TEST_ASSERT_EQUAL_STRING_MESSAGE(
+	    second,
+	    reused.__buf,
+	    "Buffer is expected to hold the second message only"
+	);
+
+	// An error is not final either
+	s = lhttp_request_reset(&reused);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(0, s, "Reset is expected to succeed");
+	s = lhttp_request_parse(&reused, "GET\r\n\r\n", 7);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(-1, s, "Parsing is expected to fail");
+	s = lhttp_request_reset(&reused);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    LHTTP_REQUEST_ERROR_NONE,
+	    reused.error,
+	    "Request error is expected to be none after a reset"
+	);
+
+	lhttp_request_free(&reused);
+
+	s = lhttp_request_reset(&reused);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    LHTTP_REQUEST_ERROR,
+	    s,
+	    "Resetting a freed request is expected to fail"
+	);
+
+	TEST_PASS_MESSAGE("Reset request test passed");
+}
+
+TEST(TEST_REQUEST, DecodeMethodAndVersion)
+{
+	lhttp_request_t decoded;
+	char message[64];
+	size_t i;
+	int s;
+
+	struct
+	{
+		const char *token;
+		lhttp_method_t method;
+	} methods[] = {
+	    {"GET",      LHTTP_METHOD_GET      },
+	    {"HEAD",     LHTTP_METHOD_HEAD     },
+	    {"POST",     LHTTP_METHOD_POST     },
+	    {"PUT",      LHTTP_METHOD_PUT      },
+	    {"DELETE",   LHTTP_METHOD_DELETE   },
+	    {"CONNECT",  LHTTP_METHOD_CONNECT  },
+	    {"OPTIONS",  LHTTP_METHOD_OPTIONS  },
+	    {"TRACE",    LHTTP_METHOD_TRACE    },
+	    {"PATCH",    LHTTP_METHOD_PATCH    },
+	    {"get",      LHTTP_METHOD_EXTENSION},
+	    {"PROPFIND", LHTTP_METHOD_EXTENSION},
+	    {"M",        LHTTP_METHOD_EXTENSION},
+	    {"POSTS",    LHTTP_METHOD_EXTENSION},
+	};
+
+	struct
+	{
+		const char *token;
+		lhttp_version_t version;
+	} versions[] = {
+	    {"HTTP/1.1", LHTTP_VERSION_1_1    },
+	    {"HTTP/1.0", LHTTP_VERSION_1_0    },
+	    {"HTTP/2.0", LHTTP_VERSION_INVALID},
+	};
+
+	for (i = 0; i < sizeof(methods) / sizeof(methods[0]); i++)
+	{
+		sprintf(message, "%s / HTTP/1.1\r\n\r\n", methods[i].token);
+		lhttp_request_init_borrowed(&decoded, strlen(message));
+
+		s = lhttp_request_parse(&decoded, message, strlen(message));
+		TEST_ASSERT_EQUAL_INT_MESSAGE(0, s, methods[i].token);
+		TEST_ASSERT_EQUAL_INT_MESSAGE(
+		    methods[i].method,
+		    decoded.method,
+		    methods[i].token
+		);
+
+		lhttp_request_free(&decoded);
+	}
+
+	for (i = 0; i < sizeof(versions) / sizeof(versions[0]); i++)
+	{
+		sprintf(message, "GET / %s\r\n\r\n", versions[i].token);
+		lhttp_request_init_borrowed(&decoded, strlen(message));
+
+		s = lhttp_request_parse(&decoded, message, strlen(message));
+		TEST_ASSERT_EQUAL_INT_MESSAGE(0, s, versions[i].token);
+		TEST_ASSERT_EQUAL_INT_MESSAGE(
+		    versions[i].version,
+		    decoded.version,
+		    versions[i].token
+		);
+
+		lhttp_request_free(&decoded);
+	}
+
+	// Methods that are not tokens and malformed versions are rejected
+	strcpy(message, "GE\"T / HTTP/1.1\r\n\r\n");
+	lhttp_request_init_borrowed(&decoded, strlen(message));
+	s = lhttp_request_parse(&decoded, message, strlen(message));
+	TEST_ASSERT_EQUAL_INT(LHTTP_REQUEST_ERROR, s);
+	TEST_ASSERT_EQUAL_INT(LHTTP_REQUEST_ERROR_METHOD, decoded.error);
+
+	strcpy(message, "GET / HTTP/1.1.1\r\n\r\n");
+	lhttp_request_init_borrowed(&decoded, strlen(message));
+	s = lhttp_request_parse(&decoded, message, strlen(message));
+	TEST_ASSERT_EQUAL_INT(LHTTP_REQUEST_ERROR, s);
+	TEST_ASSERT_EQUAL_INT(LHTTP_REQUEST_ERROR_VERSION, decoded.error);
+
+	strcpy(message, "GET / HTTP/x.1\r\n\r\n");
+	lhttp_request_init_borrowed(&decoded, strlen(message));
+	s = lhttp_request_parse(&decoded, message, strlen(message));
+	TEST_ASSERT_EQUAL_INT(LHTTP_REQUEST_ERROR, s);
+	TEST_ASSERT_EQUAL_INT(LHTTP_REQUEST_ERROR_VERSION, decoded.error);
+
+	TEST_PASS_MESSAGE("Decode method and version test passed");
+}
+
+TEST(TEST_REQUEST, ValidateRequest)
+{
+	lhttp_request_t parsed;
+	char message[16384];
+	const struct
+	{
+		const char *message;
+		int status;
+	} cases[] = {
+	    {"GET /a%20b?q=1 HTTP/1.1\r\nHost: x\r\n\r\n", 200},
+	    {"GET / HTTP/1.0\r\n\r\n", 200},
+	    {"GET / HTTP/1.1\r\nHost: x\r\nX-Bin: caf\xc3\xa9\r\n\r\n", 200},
+	    {"GET /a%2 HTTP/1.1\r\nHost: x\r\n\r\n", 400},
+	    {"GET /a%zz HTTP/1.1\r\nHost: x\r\n\r\n", 400},
+	    {"GET /<a> HTTP/1.1\r\nHost: x\r\n\r\n", 400},
+	    {"GET / HTTP/1.1\r\n\r\n", 400},
+	    {"GET / HTTP/1.1\r\nHost: x\r\nHost: y\r\n\r\n", 400},
+	    {"GET / HTTP/1.1\r\nHost: x\r\nX Y: z\r\n\r\n", 400},
+	    {"GET / HTTP/1.1\r\nHost: x\r\nX-Y: a\x01b\r\n\r\n", 400},
+	    {"GET / HTTP/2.0\r\nHost: x\r\n\r\n", 505},
+	    {"GET / HTTP/1.1\r\nHost: x\r\nX-Y\r\n\r\n", 400},
+	    {"GET / HTTQ/1.1\r\nHost: x\r\n\r\n", 400},
+	};
+	size_t i, len;
+	int s, status;
+
+	for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+	{
+		lhttp_request_init(&parsed, 1024);
+		len = strlen(cases[i].message);
+		lhttp_request_parse(&parsed, cases[i].message, len);
+
+		status = 0;
+		s      = lhttp_request_validate(&parsed, &status);
+		TEST_ASSERT_EQUAL_INT_MESSAGE(
+		    0,
+		    s,
+		    "Validating a parsed request is expected to be successful"
+		);
+		TEST_ASSERT_EQUAL_INT_MESSAGE(
+		    cases[i].status,
+		    status,
+		    cases[i].message
+		);
+
+		lhttp_request_free(&parsed);
+	}
+
+	// Over the URI limit, and over the buffer while in the URI
+	len = snprintf(message, sizeof(message), "GET /");
+	memset(message + len, 'a', LHTTP_REQUEST_MAX_URI_LENGTH);
+	len += LHTTP_REQUEST_MAX_URI_LENGTH;
+	len += snprintf(message + len, sizeof(message) - len, " HTTP/1.1\r\n");
+
+	lhttp_request_init(&parsed, sizeof(message));
+	lhttp_request_parse(&parsed, message, len);
+	lhttp_request_parse(&parsed, "Host: x\r\n\r\n", strlen("Host: x\r\n\r\n"));
+	lhttp_request_validate(&parsed, &status);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    414,
+	    status,
+	    "A long request-target is expected to be 414"
+	);
+	lhttp_request_free(&parsed);
+
+	lhttp_request_init(&parsed, 64);
+	lhttp_request_parse(&parsed, message, len);
+	lhttp_request_validate(&parsed, &status);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    414,
+	    status,
+	    "A request-target outgrowing the buffer is expected to be 414"
+	);
+	lhttp_request_free(&parsed);
+
+	// Over the field limit, and over the buffer while in the headers
+	len = snprintf(
+	    message,
+	    sizeof(message),
+	    "GET / HTTP/1.1\r\nHost: x\r\nX: "
+	);
+	memset(message + len, 'v', LHTTP_REQUEST_MAX_FIELD_LENGTH);
+	len += LHTTP_REQUEST_MAX_FIELD_LENGTH;
+	len += snprintf(message + len, sizeof(message) - len, "\r\n\r\n");
+
+	lhttp_request_init(&parsed, sizeof(message));
+	lhttp_request_parse(&parsed, message, len);
+	lhttp_request_validate(&parsed, &status);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    431,
+	    status,
+	    "A long field line is expected to be 431"
+	);
+	lhttp_request_free(&parsed);
+
+	lhttp_request_init(&parsed, 64);
+	lhttp_request_parse(&parsed, message, len);
+	lhttp_request_validate(&parsed, &status);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    431,
+	    status,
+	    "A header section outgrowing the buffer is expected to be 431"
+	);
+	lhttp_request_free(&parsed);
+
+	// Values are classified while parsing, whatever the chunks
+	len = snprintf(
+	    message,
+	    sizeof(message),
+	    "GET / HTTP/1.1\r\nHost: x\r\nCookie: %0200d\x7f%0100d\r\n"
+	    "Accept: */*\r\n\r\n",
+	    0,
+	    0
+	);
+
+	lhttp_request_init(&parsed, sizeof(message));
+	for (i = 0; i < len; i++)
+		lhttp_request_parse(&parsed, message + i, 1);
+
+	lhttp_request_validate(&parsed, &status);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    400,
+	    status,
+	    "A DEL in a value split across chunks is expected to be 400"
+	);
+	TEST_ASSERT_EQUAL_size_t_MESSAGE(
+	    3,
+	    lhttp_request_header_count(&parsed),
+	    "Illegal bytes are expected not to end the value"
+	);
+	lhttp_request_free(&parsed);
+
+	*strchr(message, '\x7f') = '0';
+
+	lhttp_request_init(&parsed, sizeof(message));
+	lhttp_request_parse(&parsed, message, len);
+	lhttp_request_validate(&parsed, &status);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    200,
+	    status,
+	    "A long clean value is expected to be valid"
+	);
+	lhttp_request_free(&parsed);
+
+	// Nothing to validate before the request is parsed
+	lhttp_request_init(&parsed, 64);
+	s = lhttp_request_validate(&parsed, &status);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    -1,
+	    s,
+	    "Validating an unparsed request is expected to fail"
+	);
+	lhttp_request_free(&parsed);
+
+	TEST_PASS_MESSAGE("Validate request test passed");
+}
+
+TEST(TEST_REQUEST, SplitUri)
+{
+	lhttp_request_t parsed;
+	char message[256];
+	const char *value;
+	size_t value_len;
+	const struct
+	{
+		const char *request_line;
+		lhttp_uri_form_t form;
+		const char *parts[LHTTP_URI_PART_COUNT];
+	} cases[] = {
+	    {"GET / HTTP/1.1", LHTTP_URI_FORM_ORIGIN, {0, 0, "/", 0, 0}},
+	    {"GET /a/b?x=1&y=2 HTTP/1.1",
+	     LHTTP_URI_FORM_ORIGIN,
+	     {0, 0, "/a/b", "x=1&y=2", 0}},
+	    {"GET /a?b?c#d?#e HTTP/1.1",
+	     LHTTP_URI_FORM_ORIGIN,
+	     {0, 0, "/a", "b?c", "d?#e"}},
+	    {"GET /a? HTTP/1.1", LHTTP_URI_FORM_ORIGIN, {0, 0, "/a", "", 0}},
+	    {"GET /a#f HTTP/1.1", LHTTP_URI_FORM_ORIGIN, {0, 0, "/a", 0, "f"}},
+	    {"GET http://example.com:80/a?q HTTP/1.1",
+	     LHTTP_URI_FORM_ABSOLUTE,
+	     {"http", "example.com:80", "/a", "q", 0}},
+	    {"GET https://example.com HTTP/1.1",
+	     LHTTP_URI_FORM_ABSOLUTE,
+	     {"https", "example.com", "", 0, 0}},
+	    {"GET urn:isbn:0451450523 HTTP/1.1",
+	     LHTTP_URI_FORM_ABSOLUTE,
+	     {"urn", 0, "isbn:0451450523", 0, 0}},
+	    {"CONNECT example.com:443 HTTP/1.1",
+	     LHTTP_URI_FORM_AUTHORITY,
+	     {0, "example.com:443", 0, 0, 0}},
+	    {"OPTIONS * HTTP/1.1", LHTTP_URI_FORM_ASTERISK, {0, 0, 0, 0, 0}},
+	    {"CONNECT /a HTTP/1.1", LHTTP_URI_FORM_INVALID, {0, 0, 0, 0, 0}},
+	    {"CONNECT a:1?q HTTP/1.1",
+	     LHTTP_URI_FORM_INVALID,
+	     {0, 0, 0, "q", 0}},
+	    {"GET *a HTTP/1.1", LHTTP_URI_FORM_INVALID, {0, 0, 0, 0, 0}},
+	    {"GET 1http://a HTTP/1.1", LHTTP_URI_FORM_INVALID, {0, 0, 0, 0, 0}},
+	    {"GET ?q HTTP/1.1", LHTTP_URI_FORM_INVALID, {0, 0, 0, "q", 0}},
+	};
+	size_t i, j, k, len;
+	int s;
+
+	for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+	{
+		len = snprintf(
+		    message,
+		    sizeof(message),
+		    "%s\r\nHost: x\r\n\r\n",
+		    cases[i].request_line
+		);
+
+		// Whole, then one byte at a time across every delimiter
+		for (k = 0; k < 2; k++)
+		{
+			lhttp_request_init(&parsed, sizeof(message));
+
+			if (k == 0)
+			{
+				s = lhttp_request_parse(&parsed, message, len);
+			}
+			else
+			{
+				for (j = 0; j < len; j++)
+					s = lhttp_request_parse(&parsed, message + j, 1);
+			}
+
+			TEST_ASSERT_EQUAL_INT_MESSAGE(0, s, cases[i].request_line);
+			TEST_ASSERT_EQUAL_INT_MESSAGE(
+			    cases[i].form,
+			    parsed.uri_form,
+			    cases[i].request_line
+			);
+			TEST_ASSERT_EQUAL_STRING_LEN_MESSAGE(
+			    strchr(message, ' ') + 1,
+			    parsed.uri,
+			    parsed.uri_len,
+			    "The URI is expected to follow the method"
+			);
+			TEST_ASSERT_EQUAL_CHAR_MESSAGE(
+			    ' ',
+			    parsed.uri[parsed.uri_len],
+			    "The URI is expected to end before the version"
+			);
+
+			for (j = 0; j < LHTTP_URI_PART_COUNT; j++)
+			{
+				s = lhttp_request_uri_part(
+				    &parsed,
+				    (lhttp_uri_part_t)j,
+				    &value,
+				    &value_len
+				);
+
+				if (cases[i].parts[j] == NULL)
+				{
+					TEST_ASSERT_EQUAL_INT_MESSAGE(
+					    -1,
+					    s,
+					    cases[i].request_line
+					);
+					continue;
+				}
+
+				TEST_ASSERT_EQUAL_INT_MESSAGE(0, s, cases[i].request_line);
+				TEST_ASSERT_EQUAL_size_t_MESSAGE(
+				    strlen(cases[i].parts[j]),
+				    value_len,
+				    cases[i].request_line
+				);
+				if (value_len > 0)
+				{
+					TEST_ASSERT_EQUAL_MEMORY_MESSAGE(
+					    cases[i].parts[j],
+					    value,
+					    value_len,
+					    cases[i].request_line
+					);
+				}
+			}
+
+			lhttp_request_free(&parsed);
+		}
+	}
+
+	// The form is checked against the method
+	lhttp_request_init(&parsed, sizeof(message));
+	len = snprintf(
+	    message,
+	    sizeof(message),
+	    "GET * HTTP/1.1\r\nHost: x\r\n\r\n"
+	);
+	lhttp_request_parse(&parsed, message, len);
+	lhttp_request_validate(&parsed, &s);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    400,
+	    s,
+	    "The asterisk-form is expected to be for OPTIONS only"
+	);
+	lhttp_request_free(&parsed);
+
+	lhttp_request_init(&parsed, sizeof(message));
+	len = snprintf(message, sizeof(message), "CONNECT /a HTTP/1.1\r\n\r\n");
+	lhttp_request_parse(&parsed, message, len);
+	lhttp_request_validate(&parsed, &s);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    400,
+	    s,
+	    "CONNECT is expected to take the authority-form only"
+	);
+	lhttp_request_free(&parsed);
+}
+
 TEST_GROUP_RUNNER(TEST_REQUEST)
 {
 	// global initialization before all tests goes here
 
 	RUN_TEST_CASE(TEST_REQUEST, InitializeRequest);
 	RUN_TEST_CASE(TEST_REQUEST, ParseRequest);
+	RUN_TEST_CASE(TEST_REQUEST, ParseRequestIncrementally);
+	RUN_TEST_CASE(TEST_REQUEST, ParseRequestTooLarge);
+	RUN_TEST_CASE(TEST_REQUEST, ParseRequestBorrowed);
+	RUN_TEST_CASE(TEST_REQUEST, ParseHeaders);
+	RUN_TEST_CASE(TEST_REQUEST, ParseInvalidHeaders);
+	RUN_TEST_CASE(TEST_REQUEST, HeaderIds);
+	RUN_TEST_CASE(TEST_REQUEST, GetKnownHeaders);
+	RUN_TEST_CASE(TEST_REQUEST, HeaderList);
+	RUN_TEST_CASE(TEST_REQUEST, ParsePipelinedRequests);
+	RUN_TEST_CASE(TEST_REQUEST, ParseRequestBody);
+	RUN_TEST_CASE(TEST_REQUEST, ParseChunkedBody);
+	RUN_TEST_CASE(TEST_REQUEST, ResetRequest);
+	RUN_TEST_CASE(TEST_REQUEST, DecodeMethodAndVersion);
+	RUN_TEST_CASE(TEST_REQUEST, ValidateRequest);
+	RUN_TEST_CASE(TEST_REQUEST, SplitUri);
 
 	// global clean up after all tests goes here
 
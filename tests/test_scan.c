@@ -0,0 +1,200 @@
+/* Copyright (c) 2024 libhttp. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <lhttp_scan.h>
+#include <string.h>
+#include <unity/unity.h>
+#include <unity/unity_fixture.h>
+
+TEST_GROUP(TEST_SCAN);
+
+char haystack[256];
+
+// Run before each test
+TEST_SETUP(TEST_SCAN)
+{
+	memset(haystack, 'a', sizeof(haystack));
+}
+
+// Run after each test
+TEST_TEAR_DOWN(TEST_SCAN) {}
+
+/* Check one implementation against every match position and range length,
+ * so that the vector bodies and the scalar tails are all exercised. */
+static void check_impl(__lhttp_scan_fn scan, const char *name)
+{
+	size_t len, pos;
+
+	for (len = 0; len <= 96; len++)
+	{
+		// No match at all must return the end of the range
+		TEST_ASSERT_EQUAL_PTR_MESSAGE(
+		    haystack + len,
+		    scan(haystack, haystack + len, " \r\n", 3),
+		    name
+		);
+		TEST_ASSERT_EQUAL_PTR_MESSAGE(
+		    haystack + len,
+		    scan(haystack, haystack + len, "?#%+\r", 5),
+		    name
+		);
+
+		for (pos = 0; pos < len; pos++)
+		{
+			haystack[pos] = '\r';
+
+			// A delimiter right past the end must never be reported
+			haystack[len] = ' ';
+
+			TEST_ASSERT_EQUAL_PTR_MESSAGE(
+			    haystack + pos,
+			    scan(haystack, haystack + len, " \r\n", 3),
+			    name
+			);
+
+			TEST_ASSERT_EQUAL_PTR_MESSAGE(
+			    haystack + pos,
+			    scan(haystack, haystack + len, "\r", 1),
+			    name
+			);
+
+			// Sets of more than four bytes take another path
+			TEST_ASSERT_EQUAL_PTR_MESSAGE(
+			    haystack + pos,
+			    scan(haystack, haystack + len, "?#%+\r", 5),
+			    name
+			);
+
+			haystack[pos] = 'a';
+			haystack[len] = 'a';
+		}
+	}
+}
+
+TEST(TEST_SCAN, ScalarScanner)
+{
+	check_impl(__lhttp_scan_find_scalar, "scalar");
+
+	TEST_PASS_MESSAGE("ScalarScanner passed");
+}
+
+TEST(TEST_SCAN, VectorScanners)
+{
+#ifdef LHTTP_SCAN_X86
+	if (__lhttp_scan_has_sse2())
+		check_impl(__lhttp_scan_find_sse2, "sse2");
+
+	if (__lhttp_scan_has_sse42())
+		check_impl(__lhttp_scan_find_sse42, "sse4.2");
+
+	if (__lhttp_scan_has_avx2())
+		check_impl(__lhttp_scan_find_avx2, "avx2");
+#endif
+
+	TEST_PASS_MESSAGE("VectorScanners passed");
+}
+
+/* Check one classifier against the definition of each class, for every block
+ * length, with byte values spread over the whole range */
+static void check_classify(__lhttp_classify_fn classify, const char *name)
+{
+	unsigned char block[LHTTP_SCAN_BLOCK + 1];
+	__lhttp_scan_classes_t classes;
+	uint64_t colon, cr, lf, illegal;
+	size_t len, i, shift;
+
+	for (shift = 0; shift < 256; shift += 7)
+	{
+		for (len = 0; len <= LHTTP_SCAN_BLOCK; len++)
+		{
+			colon = cr = lf = illegal = 0;
+
+			for (i = 0; i < len; i++)
+			{
+				block[i] = (unsigned char)(i * 37 + shift);
+
+				if (block[i] == ':')
+					colon |= 1ULL << i;
+				else if (block[i] == '\r')
+					cr |= 1ULL << i;
+				else if (block[i] == '\n')
+					lf |= 1ULL << i;
+				else if ((block[i] < 0x20 && block[i] != '\t') ||
+				         block[i] == 0x7F)
+					illegal |= 1ULL << i;
+			}
+
+			// A byte right past the end must never be classified
+			block[len] = '\r';
+
+			classify((const char *)block, len, &classes);
+
+			TEST_ASSERT_EQUAL_HEX64_MESSAGE(colon, classes.colon, name);
+			TEST_ASSERT_EQUAL_HEX64_MESSAGE(cr, classes.cr, name);
+			TEST_ASSERT_EQUAL_HEX64_MESSAGE(lf, classes.lf, name);
+			TEST_ASSERT_EQUAL_HEX64_MESSAGE(illegal, classes.illegal, name);
+		}
+	}
+}
+
+TEST(TEST_SCAN, Classifiers)
+{
+	check_classify(__lhttp_scan_classify_scalar, "scalar");
+
+#ifdef LHTTP_SCAN_X86
+	if (__lhttp_scan_has_sse2())
+		check_classify(__lhttp_scan_classify_sse2, "sse2");
+
+	if (__lhttp_scan_has_avx2())
+		check_classify(__lhttp_scan_classify_avx2, "avx2");
+#endif
+
+	check_classify(__lhttp_scan_classify, "runtime");
+
+	TEST_PASS_MESSAGE("Classifiers passed");
+}
+
+TEST(TEST_SCAN, RuntimeDispatch)
+{
+	const char *line = "GET /index.html HTTP/1.1\r\n";
+	const char *end  = line + strlen(line);
+
+	// Every boundary of the request line is found in order
+	TEST_ASSERT_EQUAL_PTR(line + 3, __lhttp_scan_find(line, end, " \r\n"));
+	TEST_ASSERT_EQUAL_PTR(line + 15, __lhttp_scan_find(line + 4, end, " \r"));
+	TEST_ASSERT_EQUAL_PTR(line + 24, __lhttp_scan_find(line + 16, end, " \r"));
+
+	TEST_ASSERT_NOT_NULL(__lhttp_scan_impl_name());
+
+	TEST_PASS_MESSAGE("RuntimeDispatch passed");
+}
+
+TEST_GROUP_RUNNER(TEST_SCAN)
+{
+	RUN_TEST_CASE(TEST_SCAN, ScalarScanner);
+	RUN_TEST_CASE(TEST_SCAN, VectorScanners);
+	RUN_TEST_CASE(TEST_SCAN, Classifiers);
+	RUN_TEST_CASE(TEST_SCAN, RuntimeDispatch);
+}
+
+static void RunAllTests(void)
+{
+	RUN_TEST_GROUP(TEST_SCAN);
+}
+
+int main(int argc, const char *argv[])
+{
+	return UnityMain(argc, argv, RunAllTests);
+}
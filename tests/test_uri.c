@@ -0,0 +1,504 @@
+/* Copyright (c) 2024 libhttp. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <lhttp_request.h>
+#include <lhttp_uri.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <unity/unity.h>
+#include <unity/unity_fixture.h>
+
+TEST_GROUP(TEST_URI);
+
+// Run before each test
+TEST_SETUP(TEST_URI) {}
+
+// Run after each test
+TEST_TEAR_DOWN(TEST_URI) {}
+
+TEST(TEST_URI, DecodeEscapes)
+{
+	char data[256];
+	size_t len;
+	const struct
+	{
+		const char *encoded;
+		lhttp_uri_decode_mode_t mode;
+		const char *decoded; // NULL when decoding is expected to fail
+	} cases[] = {
+	    {"", LHTTP_URI_DECODE_PATH, ""},
+	    {"/plain/path", LHTTP_URI_DECODE_PATH, "/plain/path"},
+	    {"/a%20b", LHTTP_URI_DECODE_PATH, "/a b"},
+	    {"%41%62%2f", LHTTP_URI_DECODE_FORM, "Ab/"},
+	    {"%5c%41", LHTTP_URI_DECODE_FORM, "\\A"},
+	    {"/%E4%BD%A0%E5%A5%BD",
+	     LHTTP_URI_DECODE_PATH,
+	     "/\xe4\xbd\xa0\xe5\xa5\xbd"},
+	    {"a+b%2B", LHTTP_URI_DECODE_PATH, "a+b+"},
+	    {"a+b%2B", LHTTP_URI_DECODE_FORM, "a b+"},
+	    {"++%20+", LHTTP_URI_DECODE_FORM, "    "},
+	    {"q=%25%32", LHTTP_URI_DECODE_PATH, "q=%2"},
+	    {"/a%2", LHTTP_URI_DECODE_PATH, NULL},
+	    {"/a%", LHTTP_URI_DECODE_PATH, NULL},
+	    {"/a%zz", LHTTP_URI_DECODE_PATH, NULL},
+	    {"/a%0g", LHTTP_URI_DECODE_PATH, NULL},
+	    {"/a%00b", LHTTP_URI_DECODE_PATH, NULL},
+	    {"a+%00", LHTTP_URI_DECODE_FORM, NULL},
+	    {"%41%62%2f", LHTTP_URI_DECODE_PATH, NULL},
+	    {"/a%2Fb", LHTTP_URI_DECODE_PATH, NULL},
+	    {"/a%5Cb", LHTTP_URI_DECODE_PATH, NULL},
+	    {"/a%5c", LHTTP_URI_DECODE_PATH, NULL},
+	};
+	size_t i;
+	int s;
+
+	for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+	{
+		strcpy(data, cases[i].encoded);
+		s = lhttp_uri_decode(data, strlen(data), cases[i].mode, &len);
+
+		if (cases[i].decoded == NULL)
+		{
+			TEST_ASSERT_EQUAL_INT_MESSAGE(-1, s, cases[i].encoded);
+			continue;
+		}
+
+		TEST_ASSERT_EQUAL_INT_MESSAGE(0, s, cases[i].encoded);
+		TEST_ASSERT_EQUAL_size_t_MESSAGE(
+		    strlen(cases[i].decoded),
+		    len,
+		    cases[i].encoded
+		);
+		TEST_ASSERT_EQUAL_STRING_LEN_MESSAGE(
+		    cases[i].decoded,
+		    data,
+		    len,
+		    cases[i].encoded
+		);
+	}
+}
+
+TEST(TEST_URI, DecodeLongRuns)
+{
+	char data[512], expected[512];
+	size_t i, j, len, n;
+	int s;
+
+	// Escapes at every offset around the 16 and 32 byte vector blocks, with
+	// the bytes past the data left as a '%' that must not be read
+	for (i = 0; i < 100; i++)
+	{
+		memset(data, 'x', sizeof(data));
+		memcpy(data + i, "%7E", 3);
+		memcpy(data + i + 40, "%7e", 3);
+		n = i + 80;
+		data[n] = '%';
+
+		for (j = 0, len = 0; j < n; j++)
+		{
+			if (j == i || j == i + 40)
+			{
+				expected[len++] = '~';
+				j += 2;
+			}
+			else
+			{
+				expected[len++] = 'x';
+			}
+		}
+
+		s = lhttp_uri_decode(data, n, LHTTP_URI_DECODE_PATH, &n);
+		TEST_ASSERT_EQUAL_INT_MESSAGE(
+		    0,
+		    s,
+		    "Decoding long runs is expected to be successful"
+		);
+		TEST_ASSERT_EQUAL_size_t_MESSAGE(
+		    len,
+		    n,
+		    "Each escape is expected to shrink by two bytes"
+		);
+		TEST_ASSERT_EQUAL_MEMORY_MESSAGE(
+		    expected,
+		    data,
+		    len,
+		    "Literal runs are expected to be moved down intact"
+		);
+	}
+}
+
+TEST(TEST_URI, DecodeRequestUri)
+{
+	lhttp_request_t request;
+	const char *message = "GET /caf%C3%A9/a+b?q=caf%C3%A9+au+lait#f%20 "
+	                      "HTTP/1.1\r\nHost: x\r\n\r\n";
+	const char *value;
+	size_t len = strlen(message), value_len;
+	int s, status;
+
+	lhttp_request_init(&request, 256);
+	lhttp_request_parse(&request, message, len);
+	lhttp_request_validate(&request, &status);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    200,
+	    status,
+	    "An encoded request-target is expected to be valid"
+	);
+
+	s = lhttp_request_uri_decode(
+	    &request,
+	    LHTTP_URI_PATH,
+	    LHTTP_URI_DECODE_PATH
+	);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(0, s, "Decoding the path is expected");
+	lhttp_request_uri_part(&request, LHTTP_URI_PATH, &value, &value_len);
+	TEST_ASSERT_EQUAL_STRING_LEN_MESSAGE(
+	    "/caf\xc3\xa9/a+b",
+	    value,
+	    value_len,
+	    "A '+' is expected to stay in the path"
+	);
+
+	s = lhttp_request_uri_decode(
+	    &request,
+	    LHTTP_URI_QUERY,
+	    LHTTP_URI_DECODE_FORM
+	);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(0, s, "Decoding the query is expected");
+	lhttp_request_uri_part(&request, LHTTP_URI_QUERY, &value, &value_len);
+	TEST_ASSERT_EQUAL_STRING_LEN_MESSAGE(
+	    "q=caf\xc3\xa9 au lait",
+	    value,
+	    value_len,
+	    "A '+' is expected to be a space in the query"
+	);
+
+	// A second decode leaves the decoded bytes alone
+	s = lhttp_request_uri_decode(
+	    &request,
+	    LHTTP_URI_QUERY,
+	    LHTTP_URI_DECODE_FORM
+	);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(0, s, "Decoding again is expected to pass");
+	lhttp_request_uri_part(&request, LHTTP_URI_QUERY, &value, &value_len);
+	TEST_ASSERT_EQUAL_size_t_MESSAGE(
+	    15,
+	    value_len,
+	    "Decoding again is expected to do nothing"
+	);
+
+	// The fragment follows untouched
+	lhttp_request_uri_part(&request, LHTTP_URI_FRAGMENT, &value, &value_len);
+	TEST_ASSERT_EQUAL_STRING_LEN_MESSAGE(
+	    "f%20",
+	    value,
+	    value_len,
+	    "Other components are expected to be left encoded"
+	);
+
+	s = lhttp_request_uri_decode(
+	    &request,
+	    LHTTP_URI_SCHEME,
+	    LHTTP_URI_DECODE_PATH
+	);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    -1,
+	    s,
+	    "A missing component is expected to fail"
+	);
+	lhttp_request_free(&request);
+
+	// The caller's buffer is never written to
+	lhttp_request_init_borrowed(&request, 256);
+	lhttp_request_parse(&request, message, len);
+	s = lhttp_request_uri_decode(
+	    &request,
+	    LHTTP_URI_PATH,
+	    LHTTP_URI_DECODE_PATH
+	);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    -1,
+	    s,
+	    "Decoding a borrowed request is expected to fail"
+	);
+	lhttp_request_free(&request);
+}
+
+TEST(TEST_URI, NormalizePath)
+{
+	char data[256];
+	size_t len;
+	const struct
+	{
+		const char *path;
+		const char *normalized; // NULL when normalizing is expected to fail
+	} cases[] = {
+	    {"", ""},
+	    {"/", "/"},
+	    {"/a/b/c.html", "/a/b/c.html"},
+	    {"/a/b/", "/a/b/"},
+	    {"//a///b//", "/a/b/"},
+	    {"/a/./b", "/a/b"},
+	    {"/a/.", "/a/"},
+	    {"/./", "/"},
+	    {"/a/b/../c", "/a/c"},
+	    {"/a/b/..", "/a/"},
+	    {"/a/b/../../c/./d/..", "/c/"},
+	    {"/a/.b/..c/...", "/a/.b/..c/..."},
+	    {"/a/%2e/b/%2E%2e/c", "/a/c"},
+	    {"/a/.%2e", "/"},
+	    {"/a/%2ex", "/a/%2ex"},
+	    {"/a//../b", "/b"},
+	    {"/..", NULL},
+	    {"/a/../..", NULL},
+	    {"/a/../../b", NULL},
+	    {"/%2e%2e/etc/passwd", NULL},
+	    {"a/b", NULL},
+	};
+	size_t i;
+	int s;
+
+	for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+	{
+		strcpy(data, cases[i].path);
+		s = lhttp_uri_normalize_path(data, strlen(data), &len);
+
+		if (cases[i].normalized == NULL)
+		{
+			TEST_ASSERT_EQUAL_INT_MESSAGE(-1, s, cases[i].path);
+			continue;
+		}
+
+		TEST_ASSERT_EQUAL_INT_MESSAGE(0, s, cases[i].path);
+		TEST_ASSERT_EQUAL_size_t_MESSAGE(
+		    strlen(cases[i].normalized),
+		    len,
+		    cases[i].path
+		);
+		TEST_ASSERT_EQUAL_STRING_LEN_MESSAGE(
+		    cases[i].normalized,
+		    data,
+		    len,
+		    cases[i].path
+		);
+	}
+}
+
+TEST(TEST_URI, NormalizeWithoutWrites)
+{
+	const char *paths[] = {
+	    "/",
+	    "/index.html",
+	    "/static/js/main.7f3c2a1b.chunk.js",
+	    "/api/v2/products/1234567/reviews/",
+	    "/a/.b/..c/.../%2ex",
+	};
+	long page = sysconf(_SC_PAGESIZE);
+	char *data;
+	size_t i, len;
+	int s;
+
+	// A read-only page faults on the first write
+	data = mmap(
+	    NULL,
+	    page,
+	    PROT_READ | PROT_WRITE,
+	    MAP_PRIVATE | MAP_ANONYMOUS,
+	    -1,
+	    0
+	);
+	TEST_ASSERT_NOT_EQUAL_MESSAGE(MAP_FAILED, data, "mmap failed");
+
+	for (i = 0; i < sizeof(paths) / sizeof(paths[0]); i++)
+	{
+		mprotect(data, page, PROT_READ | PROT_WRITE);
+		strcpy(data, paths[i]);
+		mprotect(data, page, PROT_READ);
+
+		s = lhttp_uri_normalize_path(data, strlen(paths[i]), &len);
+		TEST_ASSERT_EQUAL_INT_MESSAGE(0, s, paths[i]);
+		TEST_ASSERT_EQUAL_size_t_MESSAGE(strlen(paths[i]), len, paths[i]);
+	}
+
+	munmap(data, page);
+}
+
+TEST(TEST_URI, NormalizeRequestPath)
+{
+	lhttp_request_t request;
+	const char *message = "GET //a/./b/../c%2F..%2Fd?x=/../.. HTTP/1.1\r\n"
+	                      "Host: x\r\n\r\n";
+	const char *value;
+	size_t len = strlen(message), value_len;
+	int s;
+
+	lhttp_request_init(&request, 256);
+	lhttp_request_parse(&request, message, len);
+
+	s = lhttp_request_uri_normalize(&request);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(0, s, "Normalizing the path is expected");
+	lhttp_request_uri_part(&request, LHTTP_URI_PATH, &value, &value_len);
+	TEST_ASSERT_EQUAL_STRING_LEN_MESSAGE(
+	    "/a/c%2F..%2Fd",
+	    value,
+	    value_len,
+	    "Encoded slashes are expected to stay inside their segment"
+	);
+
+	lhttp_request_uri_part(&request, LHTTP_URI_QUERY, &value, &value_len);
+	TEST_ASSERT_EQUAL_STRING_LEN_MESSAGE(
+	    "x=/../..",
+	    value,
+	    value_len,
+	    "The query is expected to be left alone"
+	);
+	lhttp_request_free(&request);
+
+	// Decoding must not turn the normalized path into one that climbs out
+	message = "GET /a/..%2f..%2fetc HTTP/1.1\r\nHost: x\r\n\r\n";
+	len     = strlen(message);
+
+	lhttp_request_init(&request, 256);
+	lhttp_request_parse(&request, message, len);
+	s = lhttp_request_uri_normalize(&request);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    0,
+	    s,
+	    "A path with encoded slashes is expected to be normalized"
+	);
+	s = lhttp_request_uri_decode(
+	    &request,
+	    LHTTP_URI_PATH,
+	    LHTTP_URI_DECODE_PATH
+	);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    -1,
+	    s,
+	    "Decoding encoded slashes in a path is expected to fail"
+	);
+	s = lhttp_request_uri_decode(
+	    &request,
+	    LHTTP_URI_PATH,
+	    LHTTP_URI_DECODE_FORM
+	);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    -1,
+	    s,
+	    "Decoding a path as a form is expected to fail"
+	);
+	lhttp_request_free(&request);
+
+	// Not even as the first decode of a fresh request
+	lhttp_request_init(&request, 256);
+	lhttp_request_parse(&request, message, len);
+	lhttp_request_uri_normalize(&request);
+	s = lhttp_request_uri_decode(
+	    &request,
+	    LHTTP_URI_PATH,
+	    LHTTP_URI_DECODE_FORM
+	);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    -1,
+	    s,
+	    "Decoding a normalized path as a form is expected to fail"
+	);
+	lhttp_request_uri_part(&request, LHTTP_URI_PATH, &value, &value_len);
+	TEST_ASSERT_EQUAL_STRING_LEN_MESSAGE(
+	    "/a/..%2f..%2fetc",
+	    value,
+	    value_len,
+	    "A refused path is expected to be left encoded"
+	);
+	lhttp_request_free(&request);
+
+	message = "GET /a/../../etc HTTP/1.1\r\nHost: x\r\n\r\n";
+	len     = strlen(message);
+
+	lhttp_request_init(&request, 256);
+	lhttp_request_parse(&request, message, len);
+	s = lhttp_request_uri_normalize(&request);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    -1,
+	    s,
+	    "Climbing above the root is expected to fail"
+	);
+	lhttp_request_free(&request);
+
+	// A decoded path may hold "%2e" that stood for "%252e", it is refused
+	message = "GET /a/%252e%252e/b HTTP/1.1\r\nHost: x\r\n\r\n";
+	len     = strlen(message);
+
+	lhttp_request_init(&request, 256);
+	lhttp_request_parse(&request, message, len);
+	s = lhttp_request_uri_decode(
+	    &request,
+	    LHTTP_URI_PATH,
+	    LHTTP_URI_DECODE_PATH
+	);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    0,
+	    s,
+	    "A double-encoded path is expected to be decoded once"
+	);
+	s = lhttp_request_uri_normalize(&request);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    -1,
+	    s,
+	    "Normalizing a decoded path is expected to fail"
+	);
+	lhttp_request_uri_part(&request, LHTTP_URI_PATH, &value, &value_len);
+	TEST_ASSERT_EQUAL_STRING_LEN_MESSAGE(
+	    "/a/%2e%2e/b",
+	    value,
+	    value_len,
+	    "A refused path is expected to be left as decoded"
+	);
+	lhttp_request_free(&request);
+
+	message = "GET /a/../../etc HTTP/1.1\r\nHost: x\r\n\r\n";
+	len     = strlen(message);
+
+	// The caller's buffer is never written to
+	lhttp_request_init_borrowed(&request, 256);
+	lhttp_request_parse(&request, message, len);
+	s = lhttp_request_uri_normalize(&request);
+	TEST_ASSERT_EQUAL_INT_MESSAGE(
+	    -1,
+	    s,
+	    "Normalizing a borrowed request is expected to fail"
+	);
+	lhttp_request_free(&request);
+}
+
+TEST_GROUP_RUNNER(TEST_URI)
+{
+	RUN_TEST_CASE(TEST_URI, DecodeEscapes);
+	RUN_TEST_CASE(TEST_URI, DecodeLongRuns);
+	RUN_TEST_CASE(TEST_URI, DecodeRequestUri);
+	RUN_TEST_CASE(TEST_URI, NormalizePath);
+	RUN_TEST_CASE(TEST_URI, NormalizeWithoutWrites);
+	RUN_TEST_CASE(TEST_URI, NormalizeRequestPath);
+}
+
+static void RunAllTests(void)
+{
+	RUN_TEST_GROUP(TEST_URI);
+}
+
+int main(int argc, const char *argv[])
+{
+	return UnityMain(argc, argv, RunAllTests);
+}
@@ -0,0 +1,123 @@
+#!/usr/bin/env python3
+# Copyright (c) 2024 libhttp. All rights reserved.
+#
+# Generate src/lhttp_char_class.h, the table that maps every byte to the
+# character classes of RFC 9110 and RFC 3986 it belongs to, and the table of
+# hexadecimal digit values used to decode percent-encodings and chunk sizes.
+#
+# Validating a byte is then one load and one AND, whatever the class:
+#
+#     __lhttp_char_class[c] & LHTTP_CHAR_TCHAR
+#
+# Run it from the repository root after editing the classes:
+#
+#     python3 tools/gen_char_class.py > src/lhttp_char_class.h
+
+import string
+
+DIGIT = string.digits
+ALPHA = string.ascii_letters
+HEXDIG = string.hexdigits
+
+# RFC 9110 5.6.2: token = 1*tchar
+TCHAR = "!#$%&'*+-.^_`|~" + DIGIT + ALPHA
+
+# RFC 3986 2.2 and 2.3. '%' is not in the class: it starts a pct-encoded
+# triplet, which is checked on its own.
+UNRESERVED = ALPHA + DIGIT + "-._~"
+GEN_DELIMS = ":/?#[]@"
+SUB_DELIMS = "!$&'()*+,;="
+URI = UNRESERVED + GEN_DELIMS + SUB_DELIMS
+
+# RFC 3986 3.1: scheme = ALPHA *( ALPHA / DIGIT / "+" / "-" / "." )
+SCHEME = ALPHA + DIGIT + "+-."
+
+# (name, bit, description, predicate over the byte value)
+CLASSES = [
+    (
+        "LHTTP_CHAR_TCHAR",
+        0x01,
+        "Token characters of method and field names (RFC 9110 5.6.2)",
+        lambda c: chr(c) in TCHAR,
+    ),
+    (
+        "LHTTP_CHAR_FIELD",
+        0x02,
+        "Bytes of a field value: VCHAR, obs-text, SP and HTAB (RFC 9110 5.5)",
+        lambda c: 0x21 <= c <= 0x7E or c >= 0x80 or c in (0x20, 0x09),
+    ),
+    (
+        "LHTTP_CHAR_URI",
+        0x04,
+        "Literal request-target bytes: unreserved and reserved (RFC 3986)",
+        lambda c: c < 0x80 and chr(c) in URI,
+    ),
+    (
+        "LHTTP_CHAR_HEX",
+        0x08,
+        "Hexadecimal digits",
+        lambda c: c < 0x80 and chr(c) in HEXDIG,
+    ),
+    (
+        "LHTTP_CHAR_ALPHA",
+        0x10,
+        "ASCII letters, which start a URI scheme",
+        lambda c: c < 0x80 and chr(c) in ALPHA,
+    ),
+    (
+        "LHTTP_CHAR_SCHEME",
+        0x20,
+        "Bytes of a URI scheme (RFC 3986 3.1)",
+        lambda c: c < 0x80 and chr(c) in SCHEME,
+    ),
+]
+
+
+def hex_digit(c):
+    if c < 0x80 and chr(c) in HEXDIG:
+        return int(chr(c), 16)
+    return 0xFF
+
+
+def main():
+    table = []
+    for c in range(256):
+        bits = 0
+        for _, bit, _, member in CLASSES:
+            if member(c):
+                bits |= bit
+        table.append(bits)
+
+    out = []
+    out.append("/* src/lhttp_char_class.h")
+    out.append(" *")
+    out.append(" * Generated by tools/gen_char_class.py. Do not edit by hand.")
+    out.append(" */")
+    out.append("")
+    out.append("#ifndef LIBHTTP_CHAR_CLASS_H")
+    out.append("#define LIBHTTP_CHAR_CLASS_H 1")
+    out.append("")
+    for name, bit, description, _ in CLASSES:
+        out.append("/* %s */" % description)
+        out.append("#define %s 0x%02x" % (name, bit))
+        out.append("")
+    out.append("/* Classes of every byte, a combination of the bits above */")
+    out.append("static const unsigned char __lhttp_char_class[256] = {")
+    for i in range(0, 256, 8):
+        row = ", ".join("0x%02x" % b for b in table[i:i + 8])
+        out.append("\t%s, // 0x%02x" % (row, i))
+    out.append("};")
+    out.append("")
+    out.append("/* Value of every hexadecimal digit, 0xff for other bytes */")
+    out.append("static const unsigned char __lhttp_hex_digit[256] = {")
+    for i in range(0, 256, 8):
+        row = ", ".join("0x%02x" % hex_digit(c) for c in range(i, i + 8))
+        out.append("\t%s, // 0x%02x" % (row, i))
+    out.append("};")
+    out.append("")
+    out.append("#endif // LIBHTTP_CHAR_CLASS_H")
+    print("\n".join(out))
+
+
+if __name__ == "__main__":
+    main()
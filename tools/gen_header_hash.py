@@ -0,0 +1,129 @@
+#!/usr/bin/env python3
+# Copyright (c) 2024 libhttp. All rights reserved.
+#
+# Generate src/lhttp_header_hash.h, the perfect hash that maps well-known
+# header field names to `lhttp_header_id_t`.
+#
+# The hash only looks at the length and at three bytes of the name (first,
+# middle and last), folded to lowercase, so it costs the same for every name:
+#
+#     h = (A * first + B * middle + C * last + len) & (SIZE - 1)
+#
+# This script searches the multipliers that make the hash collision-free over
+# NAMES. The order of NAMES must match `lhttp_header_id_t` in
+# include/lhttp_request.h. Run it from the repository root after editing the
+# list:
+#
+#     python3 tools/gen_header_hash.py > src/lhttp_header_hash.h
+
+import sys
+
+NAMES = [
+    "accept",
+    "accept-charset",
+    "accept-encoding",
+    "accept-language",
+    "authorization",
+    "cache-control",
+    "connection",
+    "content-encoding",
+    "content-length",
+    "content-type",
+    "cookie",
+    "date",
+    "expect",
+    "forwarded",
+    "host",
+    "if-match",
+    "if-modified-since",
+    "if-none-match",
+    "if-range",
+    "if-unmodified-since",
+    "keep-alive",
+    "max-forwards",
+    "origin",
+    "pragma",
+    "proxy-authorization",
+    "range",
+    "referer",
+    "te",
+    "trailer",
+    "transfer-encoding",
+    "upgrade",
+    "user-agent",
+    "via",
+    "x-forwarded-for",
+    "x-forwarded-host",
+    "x-forwarded-proto",
+    "x-real-ip",
+    "x-request-id",
+]
+
+SIZE = 128
+
+
+def hash_name(name, a, b, c):
+    first, middle, last = name[0], name[len(name) // 2], name[-1]
+    h = a * ord(first) + b * ord(middle) + c * ord(last) + len(name)
+    return h & (SIZE - 1)
+
+
+def search():
+    for a in range(1, 64):
+        for b in range(0, 64):
+            for c in range(1, 64):
+                slots = {hash_name(n, a, b, c) for n in NAMES}
+                if len(slots) == len(NAMES):
+                    return a, b, c
+    sys.exit("no perfect hash found, grow SIZE")
+
+
+def enum_name(name):
+    return "LHTTP_HEADER_" + name.upper().replace("-", "_")
+
+
+def main():
+    a, b, c = search()
+    table = ["LHTTP_HEADER_UNKNOWN"] * SIZE
+    for name in NAMES:
+        table[hash_name(name, a, b, c)] = enum_name(name)
+
+    out = []
+    out.append("/* src/lhttp_header_hash.h")
+    out.append(" *")
+    out.append(" * Generated by tools/gen_header_hash.py. Do not edit by hand.")
+    out.append(" */")
+    out.append("")
+    out.append("#ifndef LIBHTTP_HEADER_HASH_H")
+    out.append("#define LIBHTTP_HEADER_HASH_H 1")
+    out.append("")
+    out.append("#define LHTTP_HEADER_HASH_A %d" % a)
+    out.append("#define LHTTP_HEADER_HASH_B %d" % b)
+    out.append("#define LHTTP_HEADER_HASH_C %d" % c)
+    out.append("#define LHTTP_HEADER_HASH_SIZE %d" % SIZE)
+    out.append("")
+    out.append("/* Lowercase name of every well-known header, indexed by ID */")
+    out.append("static const char *const __lhttp_header_names[] = {")
+    for name in NAMES:
+        out.append('\t"%s",' % name)
+    out.append("};")
+    out.append("")
+    out.append("/* Length of every well-known header name, indexed by ID */")
+    out.append("static const unsigned char __lhttp_header_lengths[] = {")
+    for i in range(0, len(NAMES), 8):
+        row = ", ".join(str(len(n)) for n in NAMES[i:i + 8])
+        out.append("\t%s," % row)
+    out.append("};")
+    out.append("")
+    out.append("/* Hash slot to header ID, or LHTTP_HEADER_UNKNOWN */")
+    out.append("static const unsigned char __lhttp_header_slots[] = {")
+    for i in range(0, SIZE, 2):
+        out.append("\t%s, %s," % (table[i], table[i + 1]))
+    out.append("};")
+    out.append("")
+    out.append("#endif // LIBHTTP_HEADER_HASH_H")
+    print("\n".join(out))
+
+
+if __name__ == "__main__":
+    main()